@@ -0,0 +1,46 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <cstdint>
+
+// Função de mistura do splitmix64: espalha bem qualquer entrada de 64 bits
+inline uint64_t misturar64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Gerador splitmix64 de um único avião. O estado inicial vem da semente da
+// execução e do ID do avião, então cada avião tem sua própria sequência, sem
+// estado global compartilhado entre threads: a mesma semente produz os mesmos
+// sorteios qualquer que seja a ordem em que as threads executam os aviões.
+class GeradorAviao {
+public:
+    GeradorAviao(uint64_t semente = 0, uint64_t id_aviao = 0)
+        : estado(misturar64(semente ^ misturar64(id_aviao + 0x9E3779B97F4A7C15ULL))) {}
+
+    uint64_t proximo() {
+        estado += 0x9E3779B97F4A7C15ULL;
+        return misturar64(estado);
+    }
+
+    // Inteiro uniforme em [0, n) pela multiplicação de 128 bits (sem o viés do módulo)
+    uint32_t uniforme(uint32_t n) {
+        return static_cast<uint32_t>((static_cast<unsigned __int128>(proximo()) * n) >> 64);
+    }
+
+    // Real uniforme em [0, 1) com 53 bits
+    double real() {
+        return (proximo() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Real uniforme em [-1, 1)
+    double realSimetrico() {
+        return real() * 2.0 - 1.0;
+    }
+
+private:
+    uint64_t estado;
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include "alocador.h"
+#include <algorithm>
+
+AlocadorRecursos::AlocadorRecursos(int num_recursos, Concessao ao_conceder,
+                                   std::unique_ptr<PoliticaEscalonamento> politica)
+    : ocupados(num_recursos), inicio_uso_ms(num_recursos), uso_ms(num_recursos),
+      politica(std::move(politica)), em_espera(0), fila_maxima(0), proxima_sequencia(0), atendidos_sem_espera(0),
+      ao_conceder(std::move(ao_conceder)) {}
+
+void AlocadorRecursos::iniciarUso(int recurso, int64_t agora_ms) {
+    inicio_uso_ms[recurso].store(agora_ms, std::memory_order_relaxed);
+}
+
+// Com várias threads, passos vencidos rodam fora da ordem dos prazos: quem
+// libera pode estar em um instante anterior ao do pedido estacionado. O
+// recurso não chega antes de ter sido pedido, então a concessão nunca é
+// anterior à chegada e a espera nunca é negativa.
+static int64_t instanteConcessao(const Solicitacao& solicitacao, int64_t agora_ms) {
+    return std::max(agora_ms, solicitacao.chegada_ms);
+}
+
+// Tenta reservar um recurso livre escolhido pela política sem lock; caso contrário,
+// estaciona o solicitante
+int AlocadorRecursos::solicitar(const Solicitacao& solicitacao, int64_t agora_ms) {
+    int recurso = politica->reservarRecurso(ocupados, uso_ms);
+    if(recurso != -1) {
+        iniciarUso(recurso, agora_ms);
+        atendidos_sem_espera.fetch_add(1, std::memory_order_relaxed);
+        return recurso;
+    }
+
+    TravaMedida lock(mutex, contencao_mutex);
+    // Anuncia a espera antes de tentar de novo: quem liberar depois disso vê
+    // em_espera > 0 e passa pelo mutex, então o recurso não se perde. A cerca
+    // impede que a releitura do mapa (relaxada) suba para antes do anúncio;
+    // sem ela, em ARM ou POWER os dois lados podem não se ver e o estacionado
+    // nunca seria acordado.
+    em_espera.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    recurso = politica->reservarRecurso(ocupados, uso_ms);
+    if(recurso != -1) {
+        em_espera.fetch_sub(1, std::memory_order_relaxed);
+        iniciarUso(recurso, agora_ms);
+        atendidos_sem_espera.fetch_add(1, std::memory_order_relaxed);
+        return recurso;
+    }
+
+    Solicitacao estacionada = solicitacao;
+    estacionada.sequencia = proxima_sequencia++;
+    politica->enfileirar(estacionada);
+    size_t fila = em_espera.load(std::memory_order_relaxed);
+    if(fila > fila_maxima.load(std::memory_order_relaxed)) {
+        fila_maxima.store(fila, std::memory_order_relaxed);
+    }
+    return -1;
+}
+
+// Libera o recurso; se alguém espera, o recurso continua ocupado e passa direto para ele.
+// Entre limpar o bit e reconferir a fila, um pedido novo pode pegar o recurso
+// antes de um estacionado; o estacionado é atendido na próxima liberação.
+void AlocadorRecursos::liberar(int recurso, int64_t agora_ms) {
+    uso_ms[recurso].fetch_add(agora_ms - inicio_uso_ms[recurso].load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+
+    void* proximo = nullptr;
+    int entregue = recurso;
+    if(em_espera.load(std::memory_order_seq_cst) > 0) {
+        TravaMedida lock(mutex, contencao_mutex);
+        if(!politica->vazia()) {
+            Solicitacao escolhida = politica->retirar();
+            em_espera.fetch_sub(1, std::memory_order_relaxed);
+            proximo = escolhida.solicitante;
+            int64_t concessao_ms = instanteConcessao(escolhida, agora_ms);
+            iniciarUso(recurso, concessao_ms);
+            registrarEspera(concessao_ms - escolhida.chegada_ms);
+        }
+    }
+
+    if(!proximo) {
+        ocupados.liberar(recurso);
+        // Alguém pode ter estacionado depois da conferência acima, vendo o bit
+        // ainda ocupado: se a fila não está vazia, entrega um recurso livre a ele
+        if(em_espera.load(std::memory_order_seq_cst) > 0) {
+            TravaMedida lock(mutex, contencao_mutex);
+            if(!politica->vazia()) {
+                entregue = politica->reservarRecurso(ocupados, uso_ms);
+                if(entregue != -1) {
+                    Solicitacao escolhida = politica->retirar();
+                    em_espera.fetch_sub(1, std::memory_order_relaxed);
+                    proximo = escolhida.solicitante;
+                    int64_t concessao_ms = instanteConcessao(escolhida, agora_ms);
+                    iniciarUso(entregue, concessao_ms);
+                    registrarEspera(concessao_ms - escolhida.chegada_ms);
+                }
+            }
+        }
+    }
+
+    // Acorda exatamente um solicitante, fora do lock
+    if(proximo) {
+        ao_conceder(proximo, entregue);
+    }
+}
+
+// Deve ser chamada com o mutex travado
+void AlocadorRecursos::registrarEspera(int64_t espera_ms) {
+    esperas.registrar(espera_ms);
+}
+
+std::vector<void*> AlocadorRecursos::cancelarEspera() {
+    std::vector<void*> solicitantes;
+    TravaMedida lock(mutex, contencao_mutex);
+    while(!politica->vazia()) {
+        solicitantes.push_back(politica->retirar().solicitante);
+    }
+    em_espera.store(0, std::memory_order_seq_cst);
+    return solicitantes;
+}
+
+bool AlocadorRecursos::ocupado(int recurso) const {
+    return ocupados.ocupado(recurso);
+}
+
+// Copia o estado de ocupação de todos os recursos, palavra a palavra
+void AlocadorRecursos::copiarOcupacao(std::vector<char>& destino) const {
+    ocupados.copiar(destino);
+}
+
+size_t AlocadorRecursos::emEspera() const {
+    return em_espera.load(std::memory_order_relaxed);
+}
+
+// Média e percentis das esperas registradas até agora; os atendidos sem
+// espera entram como zeros no início da distribuição. Os percentis vêm do
+// histograma (limite superior do balde, erro abaixo de ~3%); média e máxima
+// são exatas.
+EstatisticasEspera AlocadorRecursos::estatisticas() const {
+    HistogramaLatencia todas;
+    {
+        TravaMedida lock(mutex, contencao_mutex);
+        todas.combinar(esperas);
+    }
+    todas.registrar(0, atendidos_sem_espera.load(std::memory_order_relaxed));
+
+    EstatisticasEspera estatisticas;
+    if(todas.contagem() == 0) {
+        return estatisticas;
+    }
+    estatisticas.atendidos = todas.contagem();
+    estatisticas.media_ms = todas.media();
+    estatisticas.p50_ms = todas.percentil(50.0);
+    estatisticas.p95_ms = todas.percentil(95.0);
+    estatisticas.p99_ms = todas.percentil(99.0);
+    estatisticas.maxima_ms = todas.maximo();
+    return estatisticas;
+}
+
+std::vector<int64_t> AlocadorRecursos::usoAcumulado() const {
+    std::vector<int64_t> uso(uso_ms.size());
+    for(size_t i = 0; i < uso_ms.size(); ++i) {
+        uso[i] = uso_ms[i].load(std::memory_order_relaxed);
+    }
+    return uso;
+}
@@ -0,0 +1,86 @@
+#ifndef ALOCADOR_H
+#define ALOCADOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "contencao.h"
+#include "mapa_bits.h"
+#include "metricas.h"
+#include "politicas.h"
+
+// Estatísticas das esperas por recurso (do pedido até a entrega)
+struct EstatisticasEspera {
+    uint64_t atendidos = 0;
+    double media_ms = 0.0;
+    int64_t p50_ms = 0;
+    int64_t p95_ms = 0;
+    int64_t p99_ms = 0;
+    int64_t maxima_ms = 0;
+};
+
+// Alocador de recursos idênticos (as pistas) com entrega direta.
+// Quem não encontra um recurso livre fica estacionado na fila sem segurar
+// nenhum lock; ao liberar, o recurso é entregue diretamente ao próximo da
+// fila escolhido pela política, que é acordado pela função de concessão
+// com o índice do recurso.
+//
+// A ocupação fica em um mapa de bits atômico: com recurso livre, pedir e
+// liberar não tocam o mutex, que só protege a fila de estacionados e o
+// histograma de esperas. Assim o alocador escala para centenas de pistas.
+// As esperas entram em um histograma de tamanho fixo em vez de serem
+// guardadas uma a uma, então a memória não cresce com o número de pedidos.
+class AlocadorRecursos {
+public:
+    // Chamada fora do lock quando um solicitante estacionado recebe um recurso
+    using Concessao = std::function<void(void* solicitante, int recurso)>;
+
+    AlocadorRecursos(int num_recursos, Concessao ao_conceder,
+                     std::unique_ptr<PoliticaEscalonamento> politica = criarPolitica(TipoPolitica::FIFO));
+
+    // Devolve o índice de um recurso livre ou -1 se o solicitante foi estacionado
+    int solicitar(const Solicitacao& solicitacao, int64_t agora_ms);
+
+    // Libera o recurso, entregando-o ao próximo da fila se houver
+    void liberar(int recurso, int64_t agora_ms);
+
+    // Esvazia a fila e devolve os solicitantes estacionados, que não receberão
+    // mais nada (a simulação foi interrompida); quem os criou os descarta
+    std::vector<void*> cancelarEspera();
+
+    bool ocupado(int recurso) const;
+    void copiarOcupacao(std::vector<char>& destino) const;
+    size_t emEspera() const;
+    size_t filaMaxima() const { return fila_maxima.load(std::memory_order_relaxed); }
+    int numRecursos() const { return static_cast<int>(ocupados.tamanho()); }
+    const char* nomePolitica() const { return politica->nome(); }
+
+    // Esperas de todos os pedidos atendidos e tempo de uso acumulado de cada recurso
+    EstatisticasEspera estatisticas() const;
+    std::vector<int64_t> usoAcumulado() const;
+
+    // Contenção do mutex interno (disputado só quando há fila)
+    const ContadorContencao& contencao() const { return contencao_mutex; }
+
+private:
+    void registrarEspera(int64_t espera_ms);
+    void iniciarUso(int recurso, int64_t agora_ms);
+
+    mutable std::mutex mutex;
+    mutable ContadorContencao contencao_mutex;
+    MapaBitsAtomico ocupados;
+    std::vector<std::atomic<int64_t>> inicio_uso_ms;
+    std::vector<std::atomic<int64_t>> uso_ms;
+    std::unique_ptr<PoliticaEscalonamento> politica;   // Solicitantes estacionados
+    std::atomic<size_t> em_espera;                     // Tamanho da fila, visível sem o mutex
+    std::atomic<size_t> fila_maxima;                   // Maior fila já vista (atualizada sob o mutex)
+    uint64_t proxima_sequencia;
+    HistogramaLatencia esperas;                        // Só as esperas de quem foi estacionado (sob o mutex)
+    std::atomic<uint64_t> atendidos_sem_espera;
+    Concessao ao_conceder;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef ARENA_OBJETOS_H
+#define ARENA_OBJETOS_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Arena de objetos de um mesmo tipo, reciclados em vez de voltarem ao heap.
+// A memória vem em blocos de POR_BLOCO posições e cada objeto devolvido deixa
+// a sua na lista de livres para o próximo (a mais recente primeiro, ainda
+// quente no cache). Depois que a arena alcança o pico de objetos vivos, criar
+// e devolver não chamam mais o alocador do sistema e a memória fica estável,
+// por mais objetos que passem por ela. Os blocos só são liberados com a arena,
+// que deve ser destruída depois de todos os objetos devolvidos. Criar e
+// devolver podem vir de threads diferentes.
+template<typename T, size_t POR_BLOCO = 256>
+class ArenaObjetos {
+public:
+    ArenaObjetos() : vivos(0) {}
+
+    ArenaObjetos(const ArenaObjetos&) = delete;
+    ArenaObjetos& operator=(const ArenaObjetos&) = delete;
+
+    // Constrói um objeto em uma posição livre (um bloco novo se não houver)
+    template<typename... Args>
+    T* criar(Args&&... args) {
+        void* posicao;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(livres.empty()) {
+                novoBloco();
+            }
+            posicao = livres.back();
+            livres.pop_back();
+            vivos++;
+        }
+        return new(posicao) T(std::forward<Args>(args)...);
+    }
+
+    // Destrói o objeto e devolve a posição à lista de livres
+    void devolver(T* objeto) {
+        objeto->~T();
+        std::lock_guard<std::mutex> lock(mutex);
+        livres.push_back(objeto);   // Capacidade reservada em novoBloco(): não aloca
+        vivos--;
+    }
+
+    // Posições já reservadas (o pico de objetos vivos, arredondado para blocos)
+    size_t capacidade() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return blocos.size() * POR_BLOCO;
+    }
+
+    size_t emUso() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return vivos;
+    }
+
+private:
+    struct Posicao {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    // Deve ser chamada com o mutex travado
+    void novoBloco() {
+        blocos.emplace_back(new Posicao[POR_BLOCO]);
+        livres.reserve(blocos.size() * POR_BLOCO);
+        Posicao* bloco = blocos.back().get();
+        for(size_t i = POR_BLOCO; i-- > 0;) {
+            livres.push_back(&bloco[i]);
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Posicao[]>> blocos;
+    std::vector<void*> livres;
+    size_t vivos;
+};
+
+#endif
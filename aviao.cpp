@@ -1,215 +1,299 @@
 #include "aviao.h"
-#include <iostream>
-#include <pthread.h>
-#include <unistd.h>
 #include <algorithm>
-#include <cstdlib>
-
-// Define limites da tela para o movimento do avião
-constexpr float LIMITE_ESQUERDO = 50.0f;
-constexpr float LIMITE_DIREITO = 750.0f; // Supondo LARGURA_JANELA = 800
-constexpr float VELOCIDADE_MOVIMENTO = 1.0f; // Pixels por atualização
-constexpr int ATRASO_MOVIMENTO_MS = 16;   // Aproximadamente 60 FPS
 
 // Define possíveis alturas de spawn (coordenadas y)
 constexpr float POSICOES_Y_SPAWN[4] = {50.0f, 70.0f, 90.0f, 30.0f};
 
-// Função de simulação do avião
-void* aviao(void* data) {
-    AviaoData* dados_aviao = static_cast<AviaoData*>(data);
-
-    int aviao_id = dados_aviao->id;
-    int tempo_pouso = dados_aviao->tempo_pouso;
-    int tempo_desembarque = dados_aviao->tempo_desembarque;
-    int tempo_decolagem = dados_aviao->tempo_decolagem;
-    Semaforo* pistas = dados_aviao->pistas;
-    std::vector<Plane>* avioes = dados_aviao->avioes;
-    std::vector<Runway>* pistasList = dados_aviao->pistasList;
-    std::mutex* mutex_avioes = dados_aviao->mutex_avioes;
-    int atraso_inicio = dados_aviao->atraso_inicio;
-
-    // Atraso antes de iniciar a simulação baseado no id do avião e intervalo
-    if(atraso_inicio > 0) {
-        sleep(atraso_inicio);
+int64_t AviaoData::executar() {
+    return ::aviao(*this);
+}
+
+// Volta à arena sem passar pelo heap
+void AviaoData::liberar() {
+    if(arena) {
+        arena->devolver(this);
+    } else {
+        delete this;
     }
+}
 
-    std::cout << "Avião " << aviao_id << " iniciando voo.\n";
-
-    // Inicializa avião no céu
-    Plane aviao;
-    aviao.id = aviao_id;
-    aviao.x = 100.0f + (rand() % static_cast<int>(LIMITE_DIREITO - LIMITE_ESQUERDO)); // Inicia em algum lugar na tela
-    aviao.y = POSICOES_Y_SPAWN[rand() % 3]; // Seleciona aleatoriamente uma das três alturas de spawn
-    aviao.cor = {255, 255, 255, 255}; // Cor branca
-    aviao.movendoParaDireita = (rand() % 2 == 0); // Direção inicial aleatória
-    aviao.aterrissou = false;
-    aviao.pistaAtribuida = -1; // Nenhuma pista atribuída inicialmente
-
-    // Adiciona avião à lista compartilhada
-    {
-        std::lock_guard<std::mutex> lock(*mutex_avioes);
-        avioes->push_back(aviao);
-        //std::cout << "Plane " << aviao_id << " added to simulation at position (" << aviao.x << ", " << aviao.y << ").\n";
+// Copia posição, cor e pista do avião para o registro compartilhado
+static void publicarAviao(AviaoData& dados_aviao) {
+    const Plane& aviao = dados_aviao.aviao;
+    TravaMedida lock(*dados_aviao.mutex_avioes, *dados_aviao.contencao_avioes);
+    if(Plane* p = dados_aviao.avioes->obter(dados_aviao.handle)) {
+        p->aterrissou = aviao.aterrissou;
+        p->pistaAtribuida = aviao.pistaAtribuida;
+        p->x = aviao.x;
+        p->y = aviao.y;
+        p->cor = aviao.cor;
     }
+}
 
-    // Loop de movimento do avião
-    bool pousoSolicitado = false;
-    int contador_tempo_voo = 0; // Contador para simular tempo de voo antes do pouso
+// Solicitação ao alocador com a chegada agora e a prioridade do avião
+static Solicitacao montarSolicitacao(AviaoData& dados_aviao, int64_t servico_ms) {
+    dados_aviao.pedido_ms = dados_aviao.pool->instanteAtual();
+    Solicitacao solicitacao;
+    solicitacao.solicitante = &dados_aviao;
+    solicitacao.chegada_ms = dados_aviao.pedido_ms;
+    solicitacao.servico_ms = servico_ms;
+    solicitacao.prioridade = dados_aviao.emergencia ? 1 : 0;
+    return solicitacao;
+}
 
-    while(!pousoSolicitado) {
-        // Atualiza a posição do avião baseado na direção atual
-        if(aviao.movendoParaDireita) {
-            aviao.x += VELOCIDADE_MOVIMENTO;
-            if(aviao.x >= LIMITE_DIREITO) {
-                aviao.movendoParaDireita = false; // Muda direção para esquerda
-            }
-        }
-        else {
-            aviao.x -= VELOCIDADE_MOVIMENTO;
-            if(aviao.x <= LIMITE_ESQUERDO) {
-                aviao.movendoParaDireita = true; // Muda direção para direita
-            }
-        }
+// Posiciona o avião sobre a pista recebida do alocador e publica o novo estado
+static void ocuparPista(AviaoData& dados_aviao, int indice_pista, bool aposEsperar) {
+    Plane& aviao = dados_aviao.aviao;
+    const Runway& pista = (*dados_aviao.pistasList)[indice_pista];
 
-        // Atualiza a posição do avião na lista compartilhada
-        {
-            std::lock_guard<std::mutex> lock(*mutex_avioes);
-            for(auto& p : *avioes) {
-                if(p.id == aviao_id) {
-                    p.x = aviao.x;
-                    p.movendoParaDireita = aviao.movendoParaDireita;
-                    p.y = aviao.y; // Assegura que y é consistente
-                }
-            }
-        }
+    dados_aviao.indice_pista = indice_pista;
+    // A retomada nunca é anterior ao pedido (ver PoolTarefas::retomar)
+    dados_aviao.concessao_pista_ms = std::max(dados_aviao.pool->instanteAtual(), dados_aviao.pedido_ms);
+    dados_aviao.metricas->registrar(dados_aviao.desembarcou ? Latencia::ESPERA_DECOLAGEM : Latencia::ESPERA_PISTA,
+                                    dados_aviao.concessao_pista_ms - dados_aviao.pedido_ms);
+    aviao.pistaAtribuida = pista.id;
+    aviao.aterrissou = true;
+    // Atualiza a posição do avião para o centro acima da pista
+    aviao.x = pista.rect.x + pista.rect.w / 2.0f;
+    aviao.y = pista.rect.y - 10.0f; // Ligeiramente acima da pista
+    // Cor vermelha para indicar pouso; verde para a decolagem depois do portão
+    aviao.cor = dados_aviao.desembarcou ? SDL_Color{0, 255, 0, 255} : SDL_Color{255, 0, 0, 255};
+    dados_aviao.rastro->registrar(aposEsperar ? TipoRastro::PISTA_ATRIBUIDA_APOS_ESPERA : TipoRastro::PISTA_ATRIBUIDA,
+                                  aviao.id, static_cast<uint16_t>(pista.id));
 
-        // Sleep para controlar a velocidade do movimento
-        usleep(ATRASO_MOVIMENTO_MS * 1000); // Converte ms para us
+    // Atualiza o status do avião no registro compartilhado
+    publicarAviao(dados_aviao);
+}
 
-        // Simula tempo de voo antes do pouso (ex: voa por ~5 segundos)
-        contador_tempo_voo++;
-        if(contador_tempo_voo >= 300) { // 300 * 16ms ≈ 4.8 segundos
-            pousoSolicitado = true;
-        }
+// Começa o pouso ou, com portões e já desembarcado, a decolagem na pista recebida
+static int64_t usarPista(AviaoData& dados_aviao, int indice_pista, bool aposEsperar) {
+    ocuparPista(dados_aviao, indice_pista, aposEsperar);
+    if(dados_aviao.desembarcou) {
+        dados_aviao.rastro->registrar(TipoRastro::DECOLANDO, dados_aviao.id,
+                                      static_cast<uint16_t>(dados_aviao.aviao.pistaAtribuida));
+        dados_aviao.estado = EstadoAviao::DECOLANDO;
+        return 0;
     }
 
-    std::cout << "Avião " << aviao_id << " solicitando pouso...\n";
-
-    // Atribui pista
-    int pistaAtribuidaId = -1;
-    SDL_Rect pistaAtribuidaRect;
-    {
-        std::lock_guard<std::mutex> lock(*mutex_avioes);
-        // Encontra a primeira pista disponível
-        for(auto& pista : *pistasList) {
-            if(!pista.occupied) {
-                pista.occupied = true;
-                pistaAtribuidaId = pista.id;
-                aviao.pistaAtribuida = pista.id;
-                aviao.aterrissou = true;
-                // Atualiza a posição do avião para o centro acima da pista
-                aviao.x = pista.rect.x + pista.rect.w / 2.0f;
-                aviao.y = pista.rect.y - 10.0f; // Ligeiramente acima da pista
-                aviao.cor = {255, 0, 0, 255}; // Cor vermelha para indicar pouso
-                pistaAtribuidaRect = pista.rect;
-                std::cout << "Avião " << aviao_id << " atribuído à Pista " << pista.id << ".\n";
-                break;
+    // Simula tempo de pouso
+    dados_aviao.estado = EstadoAviao::POUSANDO;
+    return dados_aviao.tempo_pouso_ms;
+}
+
+// Pede uma pista para pousar (ou decolar, com portões). O estado muda antes do
+// pedido: se o avião for estacionado, quem liberar a pista pode retomá-lo em
+// outra thread antes deste passo terminar
+static int64_t pedirPista(AviaoData& dados_aviao) {
+    int64_t decolagem_ms = static_cast<int64_t>(QUADROS_DECOLAGEM) * ATRASO_MOVIMENTO_MS;
+    int64_t servico_ms = !dados_aviao.alocador_portoes
+        ? dados_aviao.tempo_pouso_ms + dados_aviao.desembarque_ms + decolagem_ms
+        : (dados_aviao.desembarcou ? decolagem_ms : dados_aviao.tempo_pouso_ms);
+    dados_aviao.estado = EstadoAviao::AGUARDANDO_PISTA;
+    Solicitacao solicitacao = montarSolicitacao(dados_aviao, servico_ms);
+    // Copiados antes do pedido: estacionado, o avião não pode mais ler o próprio estado
+    Rastreador* rastro = dados_aviao.rastro;
+    int aviao_id = dados_aviao.id;
+    int indice_pista = dados_aviao.alocador_pistas->solicitar(solicitacao, solicitacao.chegada_ms);
+    if(indice_pista == -1) {
+        // Nenhuma pista disponível: estaciona sem segurar nenhum lock
+        rastro->registrar(TipoRastro::AGUARDANDO_PISTA, aviao_id);
+        return TAREFA_SUSPENSA;
+    }
+    return usarPista(dados_aviao, indice_pista, false);
+}
+
+// Libera a pista, que passa direto para o próximo avião da fila se houver
+static void liberarPista(AviaoData& dados_aviao, int64_t agora_ms) {
+    dados_aviao.rastro->registrar(TipoRastro::LIBEROU_PISTA, dados_aviao.id,
+                                  static_cast<uint16_t>(dados_aviao.aviao.pistaAtribuida));
+    dados_aviao.metricas->registrar(Latencia::OCUPACAO_PISTA, agora_ms - dados_aviao.concessao_pista_ms);
+    int indice_pista = dados_aviao.indice_pista;
+    dados_aviao.indice_pista = -1;
+    dados_aviao.alocador_pistas->liberar(indice_pista, agora_ms);
+}
+
+// Táxi entre a fileira de pistas e a de portões, com ou sem via reservada
+static int64_t taxiar(AviaoData& dados_aviao, int indice_via) {
+    dados_aviao.indice_via = indice_via;
+    if(indice_via != -1) {
+        dados_aviao.metricas->registrar(Latencia::ESPERA_TAXI, dados_aviao.pool->instanteAtual() - dados_aviao.pedido_ms);
+    }
+    dados_aviao.aviao.y = (*dados_aviao.portoesList)[0].rect.y - 25.0f;
+    dados_aviao.aviao.pistaAtribuida = -1;
+    publicarAviao(dados_aviao);
+    dados_aviao.estado = EstadoAviao::TAXIANDO;
+    return dados_aviao.tempo_taxi_ms;
+}
+
+static int64_t pedirVia(AviaoData& dados_aviao) {
+    if(!dados_aviao.alocador_vias) {
+        return taxiar(dados_aviao, -1);
+    }
+    dados_aviao.estado = EstadoAviao::AGUARDANDO_VIA;
+    Solicitacao solicitacao = montarSolicitacao(dados_aviao, dados_aviao.tempo_taxi_ms);
+    int indice_via = dados_aviao.alocador_vias->solicitar(solicitacao, solicitacao.chegada_ms);
+    if(indice_via == -1) {
+        return TAREFA_SUSPENSA;
+    }
+    return taxiar(dados_aviao, indice_via);
+}
+
+// Estaciona o avião no portão recebido durante o desembarque
+static int64_t ocuparPortao(AviaoData& dados_aviao, int indice_portao) {
+    const Runway& portao = (*dados_aviao.portoesList)[indice_portao];
+    dados_aviao.indice_portao = indice_portao;
+    dados_aviao.metricas->registrar(Latencia::ESPERA_PORTAO, dados_aviao.pool->instanteAtual() - dados_aviao.pedido_ms);
+    dados_aviao.aviao.x = portao.rect.x + portao.rect.w / 2.0f;
+    dados_aviao.aviao.y = portao.rect.y - 10.0f;
+    publicarAviao(dados_aviao);
+    dados_aviao.rastro->registrar(TipoRastro::CHEGOU_PORTAO, dados_aviao.id, static_cast<uint16_t>(portao.id));
+
+    // Simula desembarque de passageiros
+    dados_aviao.estado = EstadoAviao::DESEMBARCANDO;
+    return dados_aviao.desembarque_ms;
+}
+
+static int64_t pedirPortao(AviaoData& dados_aviao) {
+    dados_aviao.estado = EstadoAviao::AGUARDANDO_PORTAO;
+    Solicitacao solicitacao = montarSolicitacao(dados_aviao, dados_aviao.desembarque_ms);
+    int indice_portao = dados_aviao.alocador_portoes->solicitar(solicitacao, solicitacao.chegada_ms);
+    if(indice_portao == -1) {
+        return TAREFA_SUSPENSA;
+    }
+    return ocuparPortao(dados_aviao, indice_portao);
+}
+
+// Função de simulação do avião: cada chamada executa um passo da máquina de estados.
+// As esperas que antes eram sleep/usleep viram o atraso devolvido ao pool, em
+// milissegundos do relógio da simulação.
+int64_t aviao(AviaoData& dados_aviao) {
+    int aviao_id = dados_aviao.id;
+    RegistroAvioes* avioes = dados_aviao.avioes;
+    std::mutex* mutex_avioes = dados_aviao.mutex_avioes;
+    Plane& aviao = dados_aviao.aviao;
+
+    switch(dados_aviao.estado) {
+        case EstadoAviao::AGUARDANDO_INICIO: {
+            dados_aviao.rastro->registrar(TipoRastro::INICIO_VOO, aviao_id);
+
+            // Inicializa avião no céu
+            dados_aviao.inicio_voo_ms = dados_aviao.pool->instanteAtual();
+            aviao.id = aviao_id;
+            aviao.x = 100.0f + dados_aviao.gerador.uniforme(static_cast<uint32_t>(LIMITE_DIREITO - LIMITE_ESQUERDO)); // Inicia em algum lugar na tela
+            aviao.y = POSICOES_Y_SPAWN[dados_aviao.gerador.uniforme(3)]; // Seleciona aleatoriamente uma das três alturas de spawn
+            aviao.cor = {255, 255, 255, 255}; // Cor branca
+            aviao.movendoParaDireita = (dados_aviao.gerador.uniforme(2) == 0); // Direção inicial aleatória
+            aviao.aterrissou = false;
+            aviao.pistaAtribuida = -1; // Nenhuma pista atribuída inicialmente
+
+            // Adiciona avião ao registro compartilhado e à frota movida pelo tick central
+            {
+                TravaMedida lock(*mutex_avioes, *dados_aviao.contencao_avioes);
+                dados_aviao.handle = avioes->inserir(aviao);
+                dados_aviao.frota->adicionar(dados_aviao.handle, aviao.x, aviao.y, aviao.movendoParaDireita);
             }
+
+            // Simula tempo de voo antes do pouso (ex: voa por ~5 segundos)
+            dados_aviao.estado = EstadoAviao::VOANDO;
+            return static_cast<int64_t>(QUADROS_VOO) * ATRASO_MOVIMENTO_MS; // 300 * 16ms ≈ 4.8 segundos virtuais
         }
 
-        if(pistaAtribuidaId == -1) {
-            // Nenhuma pista disponível, espera até que uma se libere
-            std::cout << "Avião " << aviao_id << " aguardando pista disponível.\n";
-            while(pistaAtribuidaId == -1) {
-                // Espera uma pista se tornar disponível
-                sleep(1); // Espera 1 segundo antes de tentar novamente
-
-                // Tenta adquirir uma pista novamente
-                for(auto& pista : *pistasList) {
-                    if(!pista.occupied) {
-                        pista.occupied = true;
-                        pistaAtribuidaId = pista.id;
-                        aviao.pistaAtribuida = pista.id;
-                        aviao.aterrissou = true;
-                        // Atualiza a posição do avião para o centro acima da pista
-                        aviao.x = pista.rect.x + pista.rect.w / 2.0f;
-                        aviao.y = pista.rect.y - 10.0f; // Ligeiramente acima da pista
-                        aviao.cor = {255, 0, 0, 255}; // Cor vermelha para indicar pouso
-                        pistaAtribuidaRect = pista.rect;
-                        std::cout << "Avião " << aviao_id << " atribuído à Pista " << pista.id << " após esperar.\n";
-                        break;
-                    }
-                }
+        case EstadoAviao::VOANDO: {
+            // Fim do voo: o avião sai da frota antes de pedir pista
+            {
+                TravaMedida lock(*mutex_avioes, *dados_aviao.contencao_avioes);
+                dados_aviao.frota->remover(dados_aviao.handle);
             }
+            dados_aviao.estado = EstadoAviao::SOLICITANDO_PISTA;
+            return 0;
         }
 
-        // Atualiza o status do avião na lista compartilhada
-        for(auto& p : *avioes) {
-            if(p.id == aviao_id) {
-                p.aterrissou = aviao.aterrissou;
-                p.pistaAtribuida = aviao.pistaAtribuida;
-                p.x = aviao.x;
-                p.y = aviao.y;
-                p.cor = aviao.cor;
-                break;
+        case EstadoAviao::SOLICITANDO_PISTA:
+            dados_aviao.rastro->registrar(TipoRastro::SOLICITA_POUSO, aviao_id);
+            return pedirPista(dados_aviao);
+
+        case EstadoAviao::AGUARDANDO_PISTA:
+            // Retomado pelo alocador com a pista entregue em recurso_concedido
+            return usarPista(dados_aviao, dados_aviao.recurso_concedido, true);
+
+        case EstadoAviao::POUSANDO:
+            dados_aviao.rastro->registrar(TipoRastro::POUSOU, aviao_id, static_cast<uint16_t>(aviao.pistaAtribuida));
+
+            if(dados_aviao.alocador_portoes) {
+                // Com portões a pista fica livre durante o táxi e o desembarque
+                liberarPista(dados_aviao, dados_aviao.pool->instanteAtual());
+                return pedirVia(dados_aviao);
             }
-        }
-    }
 
-    // Simula tempo de pouso
-    sleep(tempo_pouso);
+            // Simula desembarque de passageiros
+            dados_aviao.estado = EstadoAviao::DESEMBARCANDO;
+            return dados_aviao.desembarque_ms;
 
-    std::cout << "Avião " << aviao_id << " pousou na pista " << aviao.pistaAtribuida << ".\n";
+        case EstadoAviao::AGUARDANDO_VIA:
+            return taxiar(dados_aviao, dados_aviao.recurso_concedido);
 
-    // Simula desembarque de passageiros
-    sleep(tempo_desembarque);
-
-    // Simula decolagem
-    std::cout << "Avião " << aviao_id << " decolando da pista " << aviao.pistaAtribuida << "...\n";
-
-    // Atualiza avião para decolagem (muda cor para verde e aponta para cima)
-    {
-        std::lock_guard<std::mutex> lock(*mutex_avioes);
-        for(auto& p : *avioes) {
-            if(p.id == aviao_id) {
-                p.cor = {0, 255, 0, 255}; // Cor verde para indicar decolagem
-                break;
+        case EstadoAviao::TAXIANDO:
+            if(dados_aviao.indice_via != -1) {
+                int indice_via = dados_aviao.indice_via;
+                dados_aviao.indice_via = -1;
+                dados_aviao.alocador_vias->liberar(indice_via, dados_aviao.pool->instanteAtual());
             }
-        }
-    }
+            return dados_aviao.desembarcou ? pedirPista(dados_aviao) : pedirPortao(dados_aviao);
+
+        case EstadoAviao::AGUARDANDO_PORTAO:
+            return ocuparPortao(dados_aviao, dados_aviao.recurso_concedido);
 
-    // Implementa movimento suave para cima com orientação para cima
-    for(int i = 0; i < 20; ++i) { // Move para cima durante 20 quadros (~320ms)
-        {
-            std::lock_guard<std::mutex> lock(*mutex_avioes);
-            for(auto& p : *avioes) {
-                if(p.id == aviao_id) {
-                    p.y -= 1.0f; // Move avião para cima
-                    break;
+        case EstadoAviao::DESEMBARCANDO:
+            if(dados_aviao.alocador_portoes) {
+                // Libera o portão e taxia de volta para pedir a pista de decolagem
+                const Runway& portao = (*dados_aviao.portoesList)[dados_aviao.indice_portao];
+                dados_aviao.rastro->registrar(TipoRastro::SAIU_PORTAO, aviao_id, static_cast<uint16_t>(portao.id));
+                int indice_portao = dados_aviao.indice_portao;
+                dados_aviao.indice_portao = -1;
+                dados_aviao.desembarcou = true;
+                dados_aviao.alocador_portoes->liberar(indice_portao, dados_aviao.pool->instanteAtual());
+                return pedirVia(dados_aviao);
+            }
+
+            // Simula decolagem
+            dados_aviao.rastro->registrar(TipoRastro::DECOLANDO, aviao_id, static_cast<uint16_t>(aviao.pistaAtribuida));
+
+            // Atualiza avião para decolagem (muda cor para verde e aponta para cima)
+            {
+                TravaMedida lock(*mutex_avioes, *dados_aviao.contencao_avioes);
+                if(Plane* p = avioes->obter(dados_aviao.handle)) {
+                    p->cor = {0, 255, 0, 255}; // Cor verde para indicar decolagem
                 }
             }
-        }
-        usleep(ATRASO_MOVIMENTO_MS * 1000); // ~60 FPS
-    }
 
-    // Libera a pista
-    {
-        std::lock_guard<std::mutex> lock(*mutex_avioes);
-        for(auto& pista : *pistasList) {
-            if(pista.id == aviao.pistaAtribuida) {
-                pista.occupied = false;
-                std::cout << "Avião " << aviao_id << " liberou a pista " << pista.id << ".\n";
-                break;
+            dados_aviao.estado = EstadoAviao::DECOLANDO;
+            return 0;
+
+        case EstadoAviao::DECOLANDO:
+            // Implementa movimento suave para cima com orientação para cima
+            if(dados_aviao.quadros_decolagem < QUADROS_DECOLAGEM) { // Move para cima durante 20 quadros (~320ms)
+                {
+                    TravaMedida lock(*mutex_avioes, *dados_aviao.contencao_avioes);
+                    if(Plane* p = avioes->obter(dados_aviao.handle)) {
+                        p->y -= 1.0f; // Move avião para cima
+                    }
+                }
+                dados_aviao.quadros_decolagem++;
+                return ATRASO_MOVIMENTO_MS; // ~60 FPS
+            }
+
+            // Remove avião do registro compartilhado
+            {
+                TravaMedida lock(*mutex_avioes, *dados_aviao.contencao_avioes);
+                avioes->remover(dados_aviao.handle);
             }
-        }
 
-        // Remove avião da lista compartilhada
-        avioes->erase(std::remove_if(avioes->begin(), avioes->end(),
-            [&](const Plane& p) { return p.id == aviao_id; }), avioes->end());
+            int64_t agora_ms = dados_aviao.pool->instanteAtual();
+            dados_aviao.metricas->registrar(Latencia::CICLO_TOTAL, agora_ms - dados_aviao.inicio_voo_ms);
+            liberarPista(dados_aviao, agora_ms);
+            dados_aviao.avioes_pendentes->fetch_sub(1);
+            return TAREFA_CONCLUIDA; // O pool devolve os dados do avião à arena
     }
 
-    pistas->notificar();
-
-    delete dados_aviao; // Libera memória alocada
-    pthread_exit(NULL);
+    return TAREFA_CONCLUIDA;
 }
@@ -5,9 +5,19 @@
 #include <string>
 #include <vector>
 #include <mutex>
-#include "semaforo.h"
+#include <atomic>
 #include "utils.h"
 #include "pista.h"
+#include "configuracao.h"
+#include "aleatorio.h"
+#include "pool_tarefas.h"
+#include "alocador.h"
+#include "arena_objetos.h"
+#include "mapa_slots.h"
+#include "contencao.h"
+#include "metricas.h"
+#include "rastro.h"
+#include "frota.h"
 
 // Estrutura para armazenar dados do avião
 struct Plane {
@@ -19,20 +29,74 @@ struct Plane {
     int pistaAtribuida;   // ID da pista atribuída
 };
 
-// Estrutura para passar dados para threads dos aviões
-struct AviaoData {
+// Registro dos aviões em voo ou em solo, com busca e remoção em O(1) por handle
+using RegistroAvioes = MapaSlots<Plane>;
+
+// Estados do ciclo de vida do avião
+enum class EstadoAviao {
+    AGUARDANDO_INICIO,  // Ainda não entrou no céu
+    VOANDO,             // Na frota aérea, movido pelo tick central
+    SOLICITANDO_PISTA,  // Primeiro pedido de pista
+    AGUARDANDO_PISTA,   // Estacionado na fila do alocador até receber uma pista
+    POUSANDO,           // Na pista, durante o tempo de pouso
+    AGUARDANDO_VIA,     // Com portões: estacionado até receber uma via de táxi
+    TAXIANDO,           // Com portões: da pista ao portão ou do portão à pista
+    AGUARDANDO_PORTAO,  // Estacionado no pátio até receber um portão
+    DESEMBARCANDO,      // Na pista (ou no portão, se houver), durante o desembarque
+    DECOLANDO           // Subindo antes de liberar a pista
+};
+
+struct AviaoData;
+
+// Posições recicladas dos dados dos aviões: a memória acompanha o pico de
+// aviões simultâneos, não o total de voos da execução
+using ArenaAvioes = ArenaObjetos<AviaoData>;
+
+// Estrutura com os dados e o estado de cada avião, executado como tarefa do pool
+struct AviaoData : public TarefaPool {
     int id;
-    int tempo_pouso;
-    int tempo_desembarque;
-    int tempo_decolagem;
-    Semaforo* pistas;           // Ponteiro para semáforo
-    std::vector<Plane>* avioes;  // Ponteiro para lista compartilhada de aviões
+    int64_t tempo_pouso_ms;
+    int64_t tempo_desembarque_ms;
+    int64_t tempo_decolagem_ms;
+    int64_t desembarque_ms;      // Desembarque deste avião, já com a variação sorteada
+    bool emergencia;             // Avião em emergência (prioridade no alocador)
+    AlocadorRecursos* alocador_pistas; // Ponteiro para o alocador de pistas
+    AlocadorRecursos* alocador_vias;   // Vias de táxi (nulo: sem limite)
+    AlocadorRecursos* alocador_portoes; // Portões (nulo: desembarque na própria pista)
+    int64_t tempo_taxi_ms;
+    RegistroAvioes* avioes;      // Ponteiro para o registro compartilhado de aviões
+    FrotaAerea* frota;           // Aviões em voo, protegidos pelo mesmo mutex_avioes
     std::vector<Runway>* pistasList; // Ponteiro para lista compartilhada de pistas
+    const std::vector<Runway>* portoesList; // Posição dos portões na tela (mesma estrutura das pistas)
     std::mutex* mutex_avioes;    // Ponteiro para mutex dos aviões
-    int atraso_inicio;             // Atraso antes de iniciar a simulação
+    ContadorContencao* contencao_avioes; // Tempo de espera dos aviões pelo mutex
+    std::atomic<int>* avioes_pendentes;  // Aviões que ainda não concluíram a simulação
+    RegistroMetricas* metricas;  // Latências de espera, ocupação e ciclo total
+    Rastreador* rastro;          // Eventos do ciclo de vida (sem E/S na thread do avião)
+    const PoolTarefas* pool;       // Pool que executa o avião (instante do passo nas métricas)
+    int64_t atraso_inicio_ms;      // Chegada: atraso desde o início da simulação
+    GeradorAviao gerador;          // Sorteios deste avião (semente da execução + ID)
+    ArenaAvioes* arena = nullptr;  // Arena de onde o avião veio (nulo: criado com new)
+
+    // Estado da máquina de estados
+    EstadoAviao estado = EstadoAviao::AGUARDANDO_INICIO;
+    Plane aviao;                   // Cópia local do avião
+    HandleSlot handle;             // Handle do avião no registro compartilhado
+    int quadros_decolagem = 0;     // Quadros já subidos na decolagem
+    int indice_pista = -1;         // Índice da pista em pistasList (entregue pelo alocador)
+    int indice_via = -1;           // Via de táxi em uso (-1: nenhuma ou vias sem limite)
+    int indice_portao = -1;
+    int recurso_concedido = -1;    // Pista, via ou portão entregue pelo alocador enquanto estacionado
+    bool desembarcou = false;      // Com portões: o próximo táxi e a próxima pista são da partida
+    int64_t inicio_voo_ms = 0;     // Instantes usados nas métricas
+    int64_t pedido_ms = 0;         // Último pedido a um alocador
+    int64_t concessao_pista_ms = 0;
+
+    int64_t executar() override;
+    void liberar() override;
 };
 
-// Função de simulação do avião
-void* aviao(void* data);
+// Executa um passo da simulação do avião e devolve o atraso (ms) até o próximo passo
+int64_t aviao(AviaoData& dados_aviao);
 
 #endif
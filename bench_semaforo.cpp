@@ -0,0 +1,132 @@
+// Microbenchmark do Semaforo: compara a implementação atual (contador atômico
+// e futex) com a anterior (pthread_mutex_t + pthread_cond_t, copiada abaixo).
+// Cada thread repete wait()/notificar() segurando a licença por um instante,
+// como um avião segurando uma pista; com mais threads que licenças há disputa.
+// Imprime uma linha CSV por caso com o custo médio de um par wait + notificar
+// (o melhor de três repetições, para descontar interferências da máquina).
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <pthread.h>
+
+#include "semaforo.h"
+
+using namespace std;
+
+// Implementação anterior do Semaforo, mantida só para comparação
+class SemaforoPthread {
+public:
+    SemaforoPthread(int count = 0) : count(count) {
+        pthread_mutex_init(&mutex, NULL);
+        pthread_cond_init(&cond, NULL);
+    }
+
+    ~SemaforoPthread() {
+        pthread_mutex_destroy(&mutex);
+        pthread_cond_destroy(&cond);
+    }
+
+    void wait() {
+        pthread_mutex_lock(&mutex);
+        while(count <= 0) {
+            pthread_cond_wait(&cond, &mutex);
+        }
+        count--;
+        pthread_mutex_unlock(&mutex);
+    }
+
+    void notificar() {
+        pthread_mutex_lock(&mutex);
+        count++;
+        pthread_cond_signal(&cond);
+        pthread_mutex_unlock(&mutex);
+    }
+
+private:
+    int count;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+
+// Trabalho feito com a licença em mãos (alguns ciclos, sem chamada de sistema)
+static void segurarLicenca(int iteracoes) {
+    volatile int soma = 0;
+    for(int i = 0; i < iteracoes; ++i) {
+        soma = soma + i;
+    }
+}
+
+// Nanossegundos por par wait + notificar, somando as operações de todas as threads
+template <class S>
+static double medir(int licencas, int threads, int operacoes, int trabalho) {
+    S semaforo(licencas);
+    atomic<bool> largada(false);
+    vector<thread> grupo;
+    for(int t = 0; t < threads; ++t) {
+        grupo.emplace_back([&] {
+            while(!largada.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            for(int i = 0; i < operacoes; ++i) {
+                semaforo.wait();
+                segurarLicenca(trabalho);
+                semaforo.notificar();
+            }
+        });
+    }
+    auto inicio = chrono::steady_clock::now();
+    largada.store(true, memory_order_release);
+    for(thread& t : grupo) {
+        t.join();
+    }
+    auto duracao = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio);
+    return static_cast<double>(duracao.count()) / (static_cast<double>(operacoes) * threads);
+}
+
+template <class S>
+static double melhorDeTres(int licencas, int threads, int operacoes, int trabalho) {
+    double melhor = medir<S>(licencas, threads, operacoes, trabalho);
+    for(int r = 1; r < 3; ++r) {
+        melhor = min(melhor, medir<S>(licencas, threads, operacoes, trabalho));
+    }
+    return melhor;
+}
+
+int main(int argc, char* argv[]) {
+    bool rapido = false;
+    string rotulo = "local";
+    for(int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if(arg == "--rapido") {
+            rapido = true;
+        } else if(arg == "--rotulo" && i + 1 < argc) {
+            rotulo = argv[++i];
+        } else {
+            cerr << "Uso: " << argv[0] << " [--rapido] [--rotulo nome]" << endl;
+            return 1;
+        }
+    }
+
+    int operacoes = rapido ? 20000 : 200000;
+    unsigned nucleos = max(1u, thread::hardware_concurrency());
+    vector<int> grupos_threads = {1, 4, static_cast<int>(nucleos) * 2};
+    sort(grupos_threads.begin(), grupos_threads.end());
+    grupos_threads.erase(unique(grupos_threads.begin(), grupos_threads.end()), grupos_threads.end());
+
+    cout << "rotulo,implementacao,licencas,threads,trabalho,ns_por_par" << endl;
+    for(int licencas : {1, 3, 64}) {
+        for(int threads : grupos_threads) {
+            for(int trabalho : {0, 200}) {
+                double atual = melhorDeTres<Semaforo>(licencas, threads, operacoes, trabalho);
+                double anterior = melhorDeTres<SemaforoPthread>(licencas, threads, operacoes, trabalho);
+                cout << rotulo << ",futex," << licencas << "," << threads << "," << trabalho << "," << atual << endl;
+                cout << rotulo << ",pthread," << licencas << "," << threads << "," << trabalho << "," << anterior << endl;
+            }
+        }
+    }
+    return 0;
+}
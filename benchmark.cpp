@@ -0,0 +1,429 @@
+// Benchmark de escalabilidade: roda o núcleo da simulação sem janela sobre uma
+// grade de aviões x pistas x threads x tempos e imprime uma linha por caso em
+// CSV ou JSON, para comparar commits. Cada caso roda em um processo filho, então
+// RSS de pico e trocas de contexto medidos pelo pai são só daquele caso.
+//
+// Motores:
+//   eventos - SimulacaoHeadless (relógio virtual, uma thread)
+//   pool    - o mesmo caminho da janela (aviao(), PoolTarefas, alocador e tick
+//             central publicando quadros), com tempos zerados para durar segundos
+//   conflitos - só o avanço da frota e a grade de conflitos do tick, com todos
+//             os aviões no ar ao mesmo tempo (eventos = pares em conflito)
+//   rede    - SimulacaoRede: vários aeroportos de eventos repartidos entre
+//             threads, com aviões passando de um para outro (aviões e pistas
+//             por aeroporto; o perfil indica quantos aeroportos)
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#include "configuracao.h"
+#include "simulacao.h"
+#include "execucao.h"
+#include "grade_conflitos.h"
+#include "rede.h"
+
+using namespace std;
+
+enum class Motor {
+    EVENTOS,
+    POOL,
+    CONFLITOS,
+    REDE
+};
+
+static const char* nomeMotor(Motor motor) {
+    switch(motor) {
+        case Motor::POOL: return "pool";
+        case Motor::CONFLITOS: return "conflitos";
+        case Motor::REDE: return "rede";
+        case Motor::EVENTOS:
+        default: return "eventos";
+    }
+}
+
+// Um ponto da grade
+struct CasoBenchmark {
+    Motor motor;
+    string perfil;
+    Configuracao config;
+    unsigned threads;       // Threads do pool ou da rede (o motor de eventos usa só a principal)
+    ConfiguracaoRede rede;  // Só no motor rede
+};
+
+// Medido dentro do processo filho e enviado ao pai pelo pipe
+struct MedidaBenchmark {
+    int ok = 0;
+    int avioes_concluidos = 0;
+    int threads = 0;
+    uint64_t eventos = 0;
+    double tempo_parede_s = 0.0;
+    double tempo_simulado_s = 0.0;
+    double espera_lock_ms = 0.0;
+    uint64_t locks_contendidos = 0;
+};
+
+// Perfis de tempo (segundos): pouso, desembarque, decolagem e intervalo entre aviões
+struct PerfilTempo {
+    const char* nome;
+    int64_t pouso_ms, desembarque_ms, decolagem_ms, intervalo_ms;
+};
+
+constexpr PerfilTempo PERFIS_EVENTOS[] = {
+    {"folgado", 1000, 5000, 1000, 10000},
+    {"congestionado", 1000, 5000, 1000, 1000},
+};
+
+// Threads do processo atual segundo o kernel (-1 se /proc não existir)
+static int contarThreads() {
+    ifstream status("/proc/self/status");
+    string linha;
+    while(getline(status, linha)) {
+        if(linha.compare(0, 8, "Threads:") == 0) {
+            return atoi(linha.c_str() + 8);
+        }
+    }
+    return -1;
+}
+
+static MedidaBenchmark executarEventos(const Configuracao& config) {
+    MedidaBenchmark medida;
+    SimulacaoHeadless simulacao(config);
+    ResultadoSimulacao resultado = simulacao.executar();
+    medida.ok = 1;
+    medida.avioes_concluidos = resultado.avioes_concluidos;
+    medida.eventos = resultado.eventos_processados;
+    medida.tempo_parede_s = resultado.tempo_parede_s;
+    medida.tempo_simulado_s = resultado.tempo_simulado_ms / 1000.0;
+    medida.threads = 1;
+    return medida;
+}
+
+// Roda o caminho da janela até o último avião concluir; devolve as threads do processo durante a execução
+static int rodarPool(const Configuracao& config, unsigned num_threads, RecursosCompartilhados& recursos) {
+    for(int i = 0; i < config.num_pistas; ++i) {
+        recursos.pistas.emplace_back(i + 1, SDL_Rect{0, 500, 200, 20});
+    }
+
+    unique_ptr<PoolTarefas> pool(new PoolTarefas(recursos.relogio, num_threads));
+    iniciarSimulacao(config, recursos, *pool);
+    int threads = contarThreads();
+    if(threads < 0) {
+        threads = static_cast<int>(pool->numThreads()) + 1;
+    }
+    while(recursos.avioes_pendentes > 0) {
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    pool.reset();
+    return threads;
+}
+
+static MedidaBenchmark executarPool(const Configuracao& config, unsigned num_threads) {
+    MedidaBenchmark medida;
+    RelogioSimulacao relogio;
+    RecursosCompartilhados recursos(relogio);
+
+    auto inicio = chrono::steady_clock::now();
+    medida.threads = rodarPool(config, num_threads, recursos);
+    medida.tempo_parede_s = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    medida.ok = 1;
+    medida.avioes_concluidos = config.num_avioes;
+    medida.tempo_simulado_s = (recursos.relogio.agoraMs() - recursos.inicio_ms) / 1000.0;  // Escala 1x
+    const ContadorContencao& alocador = recursos.alocador_pistas->contencao();
+    medida.espera_lock_ms = (recursos.contencao_avioes.espera_ns + alocador.espera_ns) / 1e6;
+    medida.locks_contendidos = recursos.contencao_avioes.contendidas + alocador.contendidas;
+    return medida;
+}
+
+// Ticks de 16 ms com todos os aviões no ar, nas alturas de voo da simulação
+static MedidaBenchmark executarConflitos(const Configuracao& config) {
+    constexpr int TICKS = 60;
+    constexpr float ALTURAS[3] = {50.0f, 70.0f, 90.0f};
+    MedidaBenchmark medida;
+    FrotaAerea frota;
+    GeradorAviao gerador(config.semente, 0);
+    for(int i = 0; i < config.num_avioes; ++i) {
+        HandleSlot handle;
+        handle.indice = static_cast<uint32_t>(i);
+        float x = LIMITE_ESQUERDO + gerador.uniforme(static_cast<uint32_t>(LIMITE_DIREITO - LIMITE_ESQUERDO));
+        frota.adicionar(handle, x, ALTURAS[gerador.uniforme(3)], gerador.uniforme(2) == 0);
+    }
+
+    GradeConflitos grade;
+    auto inicio = chrono::steady_clock::now();
+    for(int t = 0; t < TICKS; ++t) {
+        frota.avancar();
+        grade.construir(frota.dadosX(), frota.dadosY(), frota.tamanho());
+        ContagemConflitos conflitos = grade.detectar();
+        medida.eventos += conflitos.violacoes + conflitos.quase_colisoes;
+    }
+    medida.tempo_parede_s = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    medida.tempo_simulado_s = TICKS * ATRASO_MOVIMENTO_MS / 1000.0;
+    medida.threads = 1;
+    medida.ok = 1;
+    return medida;
+}
+
+static MedidaBenchmark executarRede(const Configuracao& config, ConfiguracaoRede rede, unsigned num_threads) {
+    MedidaBenchmark medida;
+    rede.threads = num_threads;
+    SimulacaoRede simulacao(config, rede);
+    ResultadoRede resultado = simulacao.executar();
+    medida.ok = 1;
+    medida.avioes_concluidos = resultado.avioes_concluidos;
+    medida.eventos = resultado.eventos_processados;
+    medida.tempo_parede_s = resultado.tempo_parede_s;
+    medida.tempo_simulado_s = resultado.tempo_simulado_ms / 1000.0;
+    medida.threads = static_cast<int>(resultado.threads);
+    return medida;
+}
+
+static double segundos(const timeval& tv) {
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+// Roda o caso em um processo filho e junta a medida com o rusage dele
+static bool executarCaso(const CasoBenchmark& caso, MedidaBenchmark& medida, rusage& uso) {
+    int canal[2];
+    if(pipe(canal) != 0) {
+        return false;
+    }
+
+    pid_t filho = fork();
+    if(filho < 0) {
+        close(canal[0]);
+        close(canal[1]);
+        return false;
+    }
+    if(filho == 0) {
+        close(canal[0]);
+        cout.rdbuf(nullptr);    // O log por avião de aviao() não entra na medida
+        MedidaBenchmark resultado = caso.motor == Motor::EVENTOS ? executarEventos(caso.config)
+                                  : caso.motor == Motor::POOL ? executarPool(caso.config, caso.threads)
+                                  : caso.motor == Motor::REDE ? executarRede(caso.config, caso.rede, caso.threads)
+                                  : executarConflitos(caso.config);
+        ssize_t escrito = write(canal[1], &resultado, sizeof(resultado));
+        _exit(escrito == static_cast<ssize_t>(sizeof(resultado)) ? 0 : 1);
+    }
+
+    close(canal[1]);
+    ssize_t lido = read(canal[0], &medida, sizeof(medida));
+    close(canal[0]);
+    int status = 0;
+    if(wait4(filho, &status, 0, &uso) < 0) {
+        return false;
+    }
+    return lido == static_cast<ssize_t>(sizeof(medida)) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static vector<CasoBenchmark> montarGrade(bool rapido) {
+    vector<CasoBenchmark> grade;
+
+    vector<int> avioes_eventos = rapido ? vector<int>{10, 1000} : vector<int>{10, 1000, 100000};
+    for(const PerfilTempo& perfil : PERFIS_EVENTOS) {
+        for(int avioes : avioes_eventos) {
+            for(int pistas : {1, 3, 16}) {
+                CasoBenchmark caso;
+                caso.motor = Motor::EVENTOS;
+                caso.perfil = perfil.nome;
+                caso.config.tempo_pouso_ms = perfil.pouso_ms;
+                caso.config.tempo_desembarque_ms = perfil.desembarque_ms;
+                caso.config.tempo_decolagem_ms = perfil.decolagem_ms;
+                caso.config.tempo_entre_avioes_ms = perfil.intervalo_ms;
+                caso.config.num_avioes = avioes;
+                caso.config.num_pistas = pistas;
+                caso.threads = 1;
+                grade.push_back(caso);
+            }
+        }
+    }
+
+    // Motor com threads: tempos zerados e todos os aviões de uma vez; a duração
+    // fica no voo e na decolagem (~5 s), com pistas suficientes para não enfileirar demais
+    unsigned nucleos = max(1u, thread::hardware_concurrency());
+    vector<pair<int, int>> avioes_pistas = rapido ? vector<pair<int, int>>{{100, 8}}
+                                                  : vector<pair<int, int>>{{100, 8}, {1000, 64}, {10000, 512}};
+    vector<unsigned> threads = rapido ? vector<unsigned>{1, nucleos} : vector<unsigned>{1, 2, nucleos};
+    threads.erase(unique(threads.begin(), threads.end()), threads.end());
+    for(const auto& par : avioes_pistas) {
+        for(unsigned n : threads) {
+            CasoBenchmark caso;
+            caso.motor = Motor::POOL;
+            caso.perfil = "estresse";
+            caso.config.tempo_pouso_ms = 0;
+            caso.config.tempo_desembarque_ms = 0;
+            caso.config.tempo_decolagem_ms = 0;
+            caso.config.tempo_entre_avioes_ms = 0;
+            caso.config.num_avioes = par.first;
+            caso.config.num_pistas = par.second;
+            caso.threads = n;
+            grade.push_back(caso);
+        }
+    }
+
+    // Grade de conflitos: o custo por tick deve crescer linearmente com os aviões no ar
+    vector<int> avioes_conflitos = rapido ? vector<int>{1000, 10000} : vector<int>{1000, 10000, 100000};
+    for(int avioes : avioes_conflitos) {
+        CasoBenchmark caso;
+        caso.motor = Motor::CONFLITOS;
+        caso.perfil = "no-ar";
+        caso.config.num_avioes = avioes;
+        caso.config.num_pistas = 0;
+        caso.threads = 1;
+        grade.push_back(caso);
+    }
+
+    // Rede: o mesmo aeroporto congestionado repetido, para ver o ganho por thread
+    int avioes_rede = rapido ? 1000 : 10000;
+    for(unsigned n : threads) {
+        CasoBenchmark caso;
+        caso.motor = Motor::REDE;
+        caso.perfil = "32-aeroportos";
+        caso.config.tempo_pouso_ms = 1000;
+        caso.config.tempo_desembarque_ms = 5000;
+        caso.config.tempo_decolagem_ms = 1000;
+        caso.config.tempo_entre_avioes_ms = 1000;
+        caso.config.num_avioes = avioes_rede;
+        caso.config.num_pistas = 3;
+        caso.rede.aeroportos = 32;
+        caso.threads = n;
+        grade.push_back(caso);
+    }
+    return grade;
+}
+
+// --verificar: o motor pool a 1000x com várias threads roda passos vencidos fora
+// da ordem dos prazos, mas as esperas devem sair iguais às do headless e nunca
+// negativas (um avião retomado não volta a um instante anterior ao do pedido)
+static bool verificarPool() {
+    Configuracao config;
+    config.num_avioes = 20000;
+    config.num_pistas = 8;
+    config.tempo_entre_avioes_ms = 85;
+    config.tempo_pouso_ms = 150;
+    config.tempo_desembarque_ms = 150;
+    config.semente = 1;
+
+    SimulacaoHeadless headless(config);
+    ResultadoSimulacao esperado = headless.executar();
+
+    RelogioSimulacao relogio(1000.0);
+    RecursosCompartilhados recursos(relogio);
+    rodarPool(config, 8, recursos);
+
+    bool ok = true;
+    for(Latencia latencia : {Latencia::ESPERA_PISTA, Latencia::ESPERA_DECOLAGEM}) {
+        HistogramaLatencia pool, referencia;
+        recursos.metricas.combinar(latencia, pool);
+        headless.metricas().combinar(latencia, referencia);
+        bool igual = pool.contagem() == referencia.contagem() && pool.minimo() == referencia.minimo()
+                  && pool.maximo() == referencia.maximo() && pool.media() == referencia.media();
+        cerr << nomeLatencia(latencia) << ": pool n=" << pool.contagem() << " min=" << pool.minimo()
+             << " média=" << pool.media() << " max=" << pool.maximo() << "; headless n=" << referencia.contagem()
+             << " min=" << referencia.minimo() << " média=" << referencia.media() << " max=" << referencia.maximo()
+             << (pool.minimo() < 0 ? " (espera negativa)" : igual ? "" : " (diferente)") << endl;
+        ok = ok && igual && pool.minimo() >= 0;
+    }
+    EstatisticasEspera alocador = recursos.alocador_pistas->estatisticas();
+    if(alocador.media_ms < 0) {
+        cerr << "alocador de pistas: espera média negativa (" << alocador.media_ms << " ms)" << endl;
+        ok = false;
+    }
+    cerr << (ok ? "verificação ok" : "verificação falhou") << endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    bool rapido = false;
+    bool json = false;
+    string rotulo = "local";
+    for(int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if(arg == "--rapido") {
+            rapido = true;
+        } else if(arg == "--verificar") {
+            cout.rdbuf(nullptr);    // Só o resumo em stderr
+            return verificarPool() ? 0 : 1;
+        } else if(arg == "--formato" && i + 1 < argc) {
+            json = string(argv[++i]) == "json";
+        } else if(arg == "--rotulo" && i + 1 < argc) {
+            rotulo = argv[++i];
+        } else {
+            cerr << "Uso: " << argv[0] << " [--rapido] [--formato csv|json] [--rotulo texto] | --verificar" << endl;
+            return 1;
+        }
+    }
+
+    vector<CasoBenchmark> grade = montarGrade(rapido);
+    if(json) {
+        cout << "[\n";
+    } else {
+        cout << "rotulo,motor,perfil,avioes,pistas,threads,tempo_parede_s,cpu_s,tempo_simulado_s,"
+                "avioes_por_hora_simulada,eventos,rss_pico_kb,trocas_voluntarias,trocas_involuntarias,"
+                "espera_lock_ms,locks_contendidos\n";
+    }
+
+    bool falhou = false;
+    bool primeiro = true;
+    for(size_t i = 0; i < grade.size(); ++i) {
+        const CasoBenchmark& caso = grade[i];
+        const char* motor = nomeMotor(caso.motor);
+        cerr << "[" << i + 1 << "/" << grade.size() << "] " << motor << " " << caso.perfil << " "
+             << caso.config.num_avioes << " aviões, " << caso.config.num_pistas << " pistas, "
+             << caso.threads << " threads" << endl;
+
+        MedidaBenchmark medida;
+        rusage uso;
+        memset(&uso, 0, sizeof(uso));
+        if(!executarCaso(caso, medida, uso) || !medida.ok) {
+            cerr << "  falhou" << endl;
+            falhou = true;
+            continue;
+        }
+
+        double horas = medida.tempo_simulado_s / 3600.0;
+        double por_hora = horas > 0 ? medida.avioes_concluidos / horas : 0.0;
+        double cpu = segundos(uso.ru_utime) + segundos(uso.ru_stime);
+        long rss_kb = uso.ru_maxrss;
+#ifdef __APPLE__
+        rss_kb /= 1024;     // No macOS ru_maxrss vem em bytes
+#endif
+
+        ostringstream linha;
+        if(json) {
+            linha << (primeiro ? "  " : ",\n  ") << "{\"rotulo\": \"" << rotulo << "\", \"motor\": \"" << motor << "\", \"perfil\": \"" << caso.perfil
+                  << "\", \"avioes\": " << caso.config.num_avioes << ", \"pistas\": " << caso.config.num_pistas
+                  << ", \"threads\": " << medida.threads << ", \"tempo_parede_s\": " << medida.tempo_parede_s
+                  << ", \"cpu_s\": " << cpu << ", \"tempo_simulado_s\": " << medida.tempo_simulado_s
+                  << ", \"avioes_por_hora_simulada\": " << por_hora << ", \"eventos\": " << medida.eventos
+                  << ", \"rss_pico_kb\": " << rss_kb << ", \"trocas_voluntarias\": " << uso.ru_nvcsw
+                  << ", \"trocas_involuntarias\": " << uso.ru_nivcsw << ", \"espera_lock_ms\": " << medida.espera_lock_ms
+                  << ", \"locks_contendidos\": " << medida.locks_contendidos << "}";
+        } else {
+            linha << rotulo << "," << motor << "," << caso.perfil << "," << caso.config.num_avioes << ","
+                  << caso.config.num_pistas << "," << medida.threads << "," << medida.tempo_parede_s << ","
+                  << cpu << "," << medida.tempo_simulado_s << "," << por_hora << "," << medida.eventos << ","
+                  << rss_kb << "," << uso.ru_nvcsw << "," << uso.ru_nivcsw << "," << medida.espera_lock_ms << ","
+                  << medida.locks_contendidos << "\n";
+        }
+        cout << linha.str() << flush;
+        primeiro = false;
+    }
+
+    if(json) {
+        cout << "\n]\n";
+    }
+    return falhou ? 1 : 0;
+}
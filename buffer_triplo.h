@@ -0,0 +1,45 @@
+#ifndef BUFFER_TRIPLO_H
+#define BUFFER_TRIPLO_H
+
+#include <atomic>
+#include <cstdint>
+
+// Buffer triplo sem lock entre um único escritor e um único leitor.
+// O escritor preenche escrita() e chama publicar(); o leitor chama atualizar()
+// e lê leitura(). Nenhum dos lados espera pelo outro: a troca é um exchange atômico.
+template<typename T>
+class BufferTriplo {
+public:
+    // Buffer em que o escritor monta o próximo quadro
+    T& escrita() { return buffers[indice_escrita]; }
+
+    // Torna o quadro escrito visível ao leitor e recebe o buffer livre
+    void publicar() {
+        uint8_t anterior = meio.exchange(indice_escrita | BIT_NOVO, std::memory_order_acq_rel);
+        indice_escrita = anterior & MASCARA_INDICE;
+    }
+
+    // Passa a ler o quadro mais recente, se houver um novo; devolve se trocou
+    bool atualizar() {
+        if(!(meio.load(std::memory_order_acquire) & BIT_NOVO)) {
+            return false;
+        }
+        uint8_t anterior = meio.exchange(indice_leitura, std::memory_order_acq_rel);
+        indice_leitura = anterior & MASCARA_INDICE;
+        return true;
+    }
+
+    // Último quadro completo obtido por atualizar()
+    const T& leitura() const { return buffers[indice_leitura]; }
+
+private:
+    static constexpr uint8_t BIT_NOVO = 0x4;
+    static constexpr uint8_t MASCARA_INDICE = 0x3;
+
+    T buffers[3];
+    std::atomic<uint8_t> meio{1};   // Buffer intermediário, trocado entre escritor e leitor
+    uint8_t indice_escrita = 0;     // Usado apenas pelo escritor
+    uint8_t indice_leitura = 2;     // Usado apenas pelo leitor
+};
+
+#endif
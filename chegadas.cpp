@@ -0,0 +1,272 @@
+#include "chegadas.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "aleatorio.h"
+#include "configuracao.h"
+
+namespace {
+
+// Separa os sorteios das chegadas dos sorteios dos aviões (que usam o ID)
+constexpr uint64_t SEMENTE_CHEGADAS = 0x43484547414441ULL;
+
+// Um avião a cada intervalo, como na versão original
+class ChegadasRegulares : public FonteChegadas {
+public:
+    ChegadasRegulares(int64_t intervalo_ms, int total) : intervalo_ms(intervalo_ms), total(total), geradas(0) {}
+
+    bool proxima(int64_t& instante_ms) override {
+        if(geradas >= total) return false;
+        instante_ms = geradas++ * intervalo_ms;
+        return true;
+    }
+
+private:
+    int64_t intervalo_ms;
+    int total;
+    int geradas;
+};
+
+// Base das chegadas sorteadas: o instante acumulado em double (sem perder as
+// frações de milissegundo entre chegadas) e o gerador da fonte
+class ChegadasSorteadas : public FonteChegadas {
+public:
+    ChegadasSorteadas(const Configuracao& config, int aeroporto)
+        : gerador(config.semente ^ SEMENTE_CHEGADAS, static_cast<uint64_t>(aeroporto)),
+          intervalo_ms(static_cast<double>(config.tempo_entre_avioes_ms)), total(config.num_avioes),
+          geradas(0), instante(0.0) {}
+
+    bool proxima(int64_t& instante_ms) override {
+        if(geradas >= total) return false;
+        avancar();
+        geradas++;
+        instante_ms = std::llround(instante);
+        return true;
+    }
+
+protected:
+    // Leva `instante` até a próxima chegada
+    virtual void avancar() = 0;
+
+    // Intervalo exponencial com a média dada
+    double exponencial(double media) {
+        return -std::log(1.0 - gerador.real()) * media;
+    }
+
+    GeradorAviao gerador;
+    double intervalo_ms;
+    int total;
+    int geradas;
+    double instante;
+};
+
+// Processo de Poisson: intervalos exponenciais independentes
+class ChegadasPoisson : public ChegadasSorteadas {
+public:
+    using ChegadasSorteadas::ChegadasSorteadas;
+
+protected:
+    void avancar() override {
+        instante += exponencial(intervalo_ms);
+    }
+};
+
+// Rajadas: o início de cada rajada é um processo de Poisson e o tamanho é
+// geométrico com média TAMANHO_MEDIO_RAJADA; dentro dela os aviões vêm a um
+// décimo do intervalo médio. A taxa de longo prazo é a mesma das outras fontes.
+class ChegadasRajadas : public ChegadasSorteadas {
+public:
+    ChegadasRajadas(const Configuracao& config, int aeroporto) : ChegadasSorteadas(config, aeroporto), restantes(0) {}
+
+protected:
+    void avancar() override {
+        if(restantes > 0) {
+            restantes--;
+            instante += intervalo_ms / 10.0;
+            return;
+        }
+        instante += exponencial(intervalo_ms * TAMANHO_MEDIO_RAJADA);
+        // Geométrica em {1, 2, ...}: continua a rajada com probabilidade 1 - 1/média
+        const double continua = 1.0 - 1.0 / TAMANHO_MEDIO_RAJADA;
+        while(gerador.real() < continua) restantes++;
+    }
+
+private:
+    int restantes;      // Aviões que ainda faltam na rajada atual
+};
+
+// Ciclo diurno: Poisson com taxa (1 + A·sen) / intervalo ao longo de um dia
+// virtual, começando na madrugada (taxa mínima). Gerada por afinamento:
+// candidatas na taxa máxima, aceitas na proporção da taxa do instante.
+class ChegadasDiurnas : public ChegadasSorteadas {
+public:
+    using ChegadasSorteadas::ChegadasSorteadas;
+
+protected:
+    void avancar() override {
+        const double maxima = 1.0 + AMPLITUDE_DIURNA;
+        const double pi = 3.14159265358979323846;
+        for(;;) {
+            instante += exponencial(intervalo_ms / maxima);
+            double fase = 2.0 * pi * instante / DIA_VIRTUAL_MS - pi / 2.0;
+            double taxa = 1.0 + AMPLITUDE_DIURNA * std::sin(fase);
+            if(gerador.real() * maxima < taxa) return;
+        }
+    }
+};
+
+// Programação em arquivo, lida em blocos conforme é consumida. O binário
+// começa com ASSINATURA_CHEGADAS; qualquer outro é CSV, com o instante em
+// segundos na primeira coluna, linhas vazias e comentários (#) ignorados e um
+// cabeçalho opcional. Chegadas fora de ordem ou linhas inválidas encerram a
+// programação com um aviso.
+class ChegadasArquivo : public FonteChegadas {
+public:
+    static constexpr size_t TAMANHO_BLOCO = 1u << 16;
+
+    ChegadasArquivo() : arquivo(nullptr), binario(false), leu_dados(false), linha(0), anterior(0), encerrada(false) {}
+
+    ~ChegadasArquivo() override {
+        if(arquivo) std::fclose(arquivo);
+    }
+
+    bool abrir(const std::string& caminho, std::string& erro) {
+        this->caminho = caminho;
+        arquivo = std::fopen(caminho.c_str(), "rb");
+        if(!arquivo) {
+            erro = "Não foi possível abrir a programação de chegadas " + caminho;
+            return false;
+        }
+        std::setvbuf(arquivo, nullptr, _IOFBF, TAMANHO_BLOCO);
+        char assinatura[sizeof(ASSINATURA_CHEGADAS)];
+        size_t lidos = std::fread(assinatura, 1, sizeof(assinatura), arquivo);
+        binario = lidos == sizeof(assinatura) && std::memcmp(assinatura, ASSINATURA_CHEGADAS, sizeof(assinatura)) == 0;
+        if(!binario) std::rewind(arquivo);
+        return true;
+    }
+
+    bool proxima(int64_t& instante_ms) override {
+        if(encerrada) return false;
+        int64_t instante;
+        if(!(binario ? lerBinario(instante) : lerTexto(instante))) {
+            encerrada = true;
+            return false;
+        }
+        if(instante < anterior) {
+            avisar("chegada fora de ordem");
+            encerrada = true;
+            return false;
+        }
+        anterior = instante;
+        instante_ms = instante;
+        return true;
+    }
+
+private:
+    bool lerBinario(int64_t& instante) {
+        unsigned char bytes[8];
+        size_t lidos = std::fread(bytes, 1, sizeof(bytes), arquivo);
+        if(lidos == 0) return false;
+        linha++;
+        if(lidos < sizeof(bytes)) {
+            avisar("registro incompleto no fim do arquivo");
+            return false;
+        }
+        uint64_t valor = 0;
+        for(int i = 7; i >= 0; i--) valor = (valor << 8) | bytes[i];
+        instante = static_cast<int64_t>(valor);
+        return true;
+    }
+
+    bool lerTexto(int64_t& instante) {
+        char buffer[256];
+        while(std::fgets(buffer, sizeof(buffer), arquivo)) {
+            linha++;
+            if(!std::strchr(buffer, '\n') && !std::feof(arquivo)) {
+                avisar("linha longa demais");
+                return false;
+            }
+            const char* inicio = buffer;
+            while(*inicio == ' ' || *inicio == '\t') inicio++;
+            if(*inicio == '#' || *inicio == '\n' || *inicio == '\r' || *inicio == '\0') continue;
+
+            char* fim;
+            double segundos = std::strtod(inicio, &fim);
+            bool valido = fim != inicio && (*fim == ',' || *fim == ';' || *fim == ' ' || *fim == '\t' ||
+                                            *fim == '\n' || *fim == '\r' || *fim == '\0');
+            if(!valido) {
+                // Só a primeira linha de dados pode ser um cabeçalho
+                if(!leu_dados) {
+                    leu_dados = true;
+                    continue;
+                }
+                avisar("instante inválido");
+                return false;
+            }
+            leu_dados = true;
+            if(!(segundos >= 0.0) || segundos > 9.0e12) {
+                avisar("instante fora do intervalo");
+                return false;
+            }
+            instante = std::llround(segundos * 1000.0);
+            return true;
+        }
+        return false;
+    }
+
+    void avisar(const char* problema) {
+        std::cerr << "Programação de chegadas " << caminho << ", " << (binario ? "registro " : "linha ")
+                  << linha << ": " << problema << "; as chegadas seguintes foram ignoradas" << std::endl;
+    }
+
+    std::FILE* arquivo;
+    std::string caminho;
+    bool binario;
+    bool leu_dados;         // Já passou da primeira linha de dados (ou do cabeçalho)
+    uint64_t linha;         // Linha (CSV) ou registro (binário) atual, para os avisos
+    int64_t anterior;
+    bool encerrada;
+};
+
+} // namespace
+
+std::unique_ptr<FonteChegadas> criarFonteChegadas(const Configuracao& config, int aeroporto, std::string& erro) {
+    switch(config.chegadas) {
+        case TipoChegadas::POISSON:
+            return std::unique_ptr<FonteChegadas>(new ChegadasPoisson(config, aeroporto));
+        case TipoChegadas::RAJADAS:
+            return std::unique_ptr<FonteChegadas>(new ChegadasRajadas(config, aeroporto));
+        case TipoChegadas::DIURNA:
+            return std::unique_ptr<FonteChegadas>(new ChegadasDiurnas(config, aeroporto));
+        case TipoChegadas::ARQUIVO: {
+            std::unique_ptr<ChegadasArquivo> fonte(new ChegadasArquivo());
+            if(!fonte->abrir(config.arquivo_chegadas, erro)) return nullptr;
+            return std::unique_ptr<FonteChegadas>(fonte.release());
+        }
+        case TipoChegadas::REGULAR:
+        default:
+            return std::unique_ptr<FonteChegadas>(new ChegadasRegulares(config.tempo_entre_avioes_ms, config.num_avioes));
+    }
+}
+
+bool chegadasPorNome(const std::string& nome, TipoChegadas& tipo) {
+    if(nome == "regular") tipo = TipoChegadas::REGULAR;
+    else if(nome == "poisson") tipo = TipoChegadas::POISSON;
+    else if(nome == "rajadas") tipo = TipoChegadas::RAJADAS;
+    else if(nome == "diurna") tipo = TipoChegadas::DIURNA;
+    else return false;
+    return true;
+}
+
+const char* nomeChegadas(TipoChegadas tipo) {
+    switch(tipo) {
+        case TipoChegadas::POISSON: return "poisson";
+        case TipoChegadas::RAJADAS: return "rajadas";
+        case TipoChegadas::DIURNA: return "diurna";
+        case TipoChegadas::ARQUIVO: return "arquivo";
+        case TipoChegadas::REGULAR:
+        default: return "regular";
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef CHEGADAS_H
+#define CHEGADAS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct Configuracao;
+
+// Como os aviões chegam ao aeroporto
+enum class TipoChegadas {
+    REGULAR,    // Um avião a cada intervalo, a partir do instante zero (o modelo original)
+    POISSON,    // Intervalos exponenciais com média igual ao intervalo
+    RAJADAS,    // Grupos de aviões em sequência, com a mesma taxa média
+    DIURNA,     // Poisson com a taxa subindo e descendo ao longo de um dia virtual
+    ARQUIVO     // Programação lida de um arquivo CSV ou binário
+};
+
+// Assinatura da programação binária: depois dela, um int64_t little-endian
+// por chegada, em milissegundos desde o início
+constexpr char ASSINATURA_CHEGADAS[8] = {'C', 'H', 'E', 'G', 'A', 'D', '0', '1'};
+
+// Parâmetros das chegadas sorteadas
+constexpr int TAMANHO_MEDIO_RAJADA = 5;             // Aviões por rajada, em média
+constexpr int64_t DIA_VIRTUAL_MS = 24LL * 3600 * 1000;
+constexpr double AMPLITUDE_DIURNA = 0.8;            // A taxa varia entre 20% e 180% da média
+
+// Fonte de chegadas consumida aos poucos: cada chamada devolve o instante da
+// próxima chegada, em milissegundos desde o início e em ordem não decrescente.
+// Nenhuma fonte guarda a programação inteira, então a memória não depende do
+// número de voos: as sorteadas geram a próxima chegada a partir da semente e a
+// de arquivo lê o arquivo em blocos.
+class FonteChegadas {
+public:
+    virtual ~FonteChegadas() = default;
+
+    // Devolve false quando não há mais chegadas
+    virtual bool proxima(int64_t& instante_ms) = 0;
+};
+
+// Cria a fonte da configuração: num_avioes chegadas sorteadas (o aeroporto da
+// rede separa os sorteios de cada um) ou todas as do arquivo. Se o arquivo não
+// abrir, devolve nulo e descreve o problema em `erro`.
+std::unique_ptr<FonteChegadas> criarFonteChegadas(const Configuracao& config, int aeroporto, std::string& erro);
+
+// Converte entre o nome usado na linha de comando e o tipo das chegadas
+bool chegadasPorNome(const std::string& nome, TipoChegadas& tipo);
+const char* nomeChegadas(TipoChegadas tipo);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef CONFIGURACAO_H
+#define CONFIGURACAO_H
+
+#include <cstdint>
+#include <string>
+#include "aleatorio.h"
+#include "chegadas.h"
+#include "politicas.h"
+
+// Estrutura de configurações (tempos em milissegundos do relógio da simulação)
+struct Configuracao {
+    int64_t tempo_pouso_ms = 1000;
+    int64_t tempo_desembarque_ms = 5000;
+    int64_t tempo_decolagem_ms = 1000;
+    int64_t tempo_entre_avioes_ms = 10000;     // Intervalo entre chegadas (a média, nas sorteadas)
+    int num_pistas = 2;
+    int num_avioes = 5;                 // Chegadas sorteadas; com arquivo, todas as do arquivo
+    TipoChegadas chegadas = TipoChegadas::REGULAR;
+    std::string arquivo_chegadas;       // Programação de TipoChegadas::ARQUIVO
+    TipoPolitica politica_pistas = TipoPolitica::FIFO;  // Quem da fila recebe a próxima pista
+    int percentual_emergencias = 0;     // % de aviões em emergência (prioridade na política "prioridade")
+    int variacao_desembarque = 0;       // ± % de variação do tempo de desembarque entre aviões
+    uint64_t semente = 0;               // Mesma semente, mesmos sorteios (0 na versão gráfica: tirada do relógio)
+
+    // Estágios em solo. Sem portões o avião desembarca na própria pista e a
+    // segura do pouso à decolagem; com portões ela fica livre entre o pouso e
+    // a decolagem, e o avião taxia até um portão e depois de volta.
+    int num_portoes = 0;                // 0: desembarque na pista
+    int num_vias_taxi = 0;              // Vias de táxi usadas uma por avião (0: sem limite)
+    int64_t tempo_taxi_ms = 0;          // Cada trecho entre pista e portão
+};
+
+// Constantes do ciclo de vida do avião, compartilhadas entre aviao.cpp e a simulação headless
+constexpr int ATRASO_MOVIMENTO_MS = 16;   // Aproximadamente 60 FPS
+constexpr int QUADROS_VOO = 300;          // 300 * 16ms ≈ 4.8 segundos de voo antes do pouso
+constexpr int QUADROS_DECOLAGEM = 20;     // 20 * 16ms ≈ 320ms subindo na decolagem
+constexpr int MAX_PISTAS = 512;           // Limite da versão gráfica (a grade de pistas cabe no solo)
+
+// Sorteios de um avião que não dependem da tela, feitos na criação e na mesma
+// ordem pela versão gráfica e pela headless: a mesma semente dá a mesma carga
+struct SorteioAviao {
+    int64_t desembarque_ms;     // Desembarque com a variação configurada
+    bool emergencia;
+};
+
+inline SorteioAviao sortearAviao(const Configuracao& config, GeradorAviao& gerador) {
+    SorteioAviao sorteio;
+    double fator = 1.0 + gerador.realSimetrico() * config.variacao_desembarque / 100.0;
+    sorteio.desembarque_ms = static_cast<int64_t>(config.tempo_desembarque_ms * fator + 0.5);
+    sorteio.emergencia = static_cast<int>(gerador.uniforme(100)) < config.percentual_emergencias;
+    return sorteio;
+}
+
+#endif
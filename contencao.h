@@ -0,0 +1,42 @@
+#ifndef CONTENCAO_H
+#define CONTENCAO_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// Contadores de contenção de um mutex
+struct ContadorContencao {
+    std::atomic<uint64_t> aquisicoes{0};
+    std::atomic<uint64_t> contendidas{0};   // Aquisições que precisaram esperar
+    std::atomic<uint64_t> espera_ns{0};     // Tempo total esperando pelo mutex
+};
+
+// Equivalente a std::lock_guard que mede quanto tempo se esperou pelo mutex.
+// O caminho sem disputa é um try_lock e não lê o relógio.
+class TravaMedida {
+public:
+    TravaMedida(std::mutex& mutex, ContadorContencao& contador) : mutex(mutex) {
+        contador.aquisicoes.fetch_add(1, std::memory_order_relaxed);
+        if(mutex.try_lock()) {
+            return;
+        }
+        auto inicio = std::chrono::steady_clock::now();
+        mutex.lock();
+        auto espera = std::chrono::steady_clock::now() - inicio;
+        contador.contendidas.fetch_add(1, std::memory_order_relaxed);
+        contador.espera_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(espera).count(),
+                                     std::memory_order_relaxed);
+    }
+
+    ~TravaMedida() { mutex.unlock(); }
+
+    TravaMedida(const TravaMedida&) = delete;
+    TravaMedida& operator=(const TravaMedida&) = delete;
+
+private:
+    std::mutex& mutex;
+};
+
+#endif
@@ -0,0 +1,35 @@
+// Decodificador offline do rastro binário gravado pela simulação (--rastro).
+// Imprime as mesmas mensagens que os aviões escreviam no terminal, em ordem de
+// tempo e com o instante relativo ao primeiro evento.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "rastro.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        cerr << "Uso: " << argv[0] << " arquivo_de_rastro [--sem-tempo]" << endl;
+        return 1;
+    }
+    bool com_tempo = !(argc > 2 && string(argv[2]) == "--sem-tempo");
+
+    vector<EventoRastro> eventos;
+    if(!lerRastro(argv[1], eventos)) {
+        cerr << "Não foi possível ler o rastro " << argv[1] << endl;
+        return 1;
+    }
+
+    uint64_t inicio = eventos.empty() ? 0 : eventos.front().tempo_ns;
+    cout << fixed << setprecision(3);
+    for(const EventoRastro& evento : eventos) {
+        if(com_tempo) {
+            cout << "[" << setw(9) << (evento.tempo_ns - inicio) / 1e9 << " s] ";
+        }
+        imprimirEventoRastro(cout, evento);
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include "execucao.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Antecedência com que a fonte cria os aviões: só os que entram no céu dentro
+// dela existem antes da hora, então a memória acompanha os aviões em
+// andamento, não a programação inteira
+constexpr int64_t ANTECEDENCIA_CHEGADA_MS = 1000;
+
+// Tarefa que consome a fonte de chegadas e agenda a tarefa de cada avião para
+// o instante da sua chegada. Enquanto a fonte não se esgota ela conta como um
+// avião pendente, então a simulação não termina entre duas chegadas espaçadas.
+class TarefaChegadas : public TarefaPool {
+public:
+    TarefaChegadas(const Configuracao& config, RecursosCompartilhados& recursos, PoolTarefas& pool,
+                   std::unique_ptr<FonteChegadas> fonte)
+        : config(config), recursos(recursos), pool(pool), fonte(std::move(fonte)), proximo_id(1) {
+        ha_proxima = this->fonte->proxima(proxima_ms);
+    }
+
+    int64_t executar() override {
+        int64_t agora = pool.instanteAtual() - recursos.inicio_ms;
+        while(ha_proxima && proxima_ms <= agora + ANTECEDENCIA_CHEGADA_MS) {
+            recursos.avioes_pendentes++;
+            pool.agendar(criarAviao(proximo_id++, proxima_ms), std::max<int64_t>(0, proxima_ms - agora));
+            ha_proxima = fonte->proxima(proxima_ms);
+        }
+        if(!ha_proxima) {
+            recursos.avioes_pendentes--;
+            return TAREFA_CONCLUIDA;
+        }
+        return proxima_ms - ANTECEDENCIA_CHEGADA_MS - agora;
+    }
+
+private:
+    AviaoData* criarAviao(int id, int64_t chegada_ms) {
+        AviaoData* dados_aviao = recursos.arena_avioes.criar();
+        dados_aviao->arena = &recursos.arena_avioes;
+        dados_aviao->id = id;
+        dados_aviao->tempo_pouso_ms = config.tempo_pouso_ms;
+        dados_aviao->tempo_desembarque_ms = config.tempo_desembarque_ms;
+        dados_aviao->gerador = GeradorAviao(config.semente, id);
+        SorteioAviao sorteio = sortearAviao(config, dados_aviao->gerador);
+        dados_aviao->desembarque_ms = sorteio.desembarque_ms;
+        dados_aviao->emergencia = sorteio.emergencia;
+        dados_aviao->tempo_decolagem_ms = config.tempo_decolagem_ms;
+        dados_aviao->alocador_pistas = recursos.alocador_pistas.get();
+        dados_aviao->alocador_vias = recursos.alocador_vias.get();
+        dados_aviao->alocador_portoes = recursos.alocador_portoes.get();
+        dados_aviao->tempo_taxi_ms = config.tempo_taxi_ms;
+        dados_aviao->avioes = &recursos.avioes;
+        dados_aviao->frota = &recursos.frota;
+        dados_aviao->pistasList = &recursos.pistas; // Passa pistas para as tarefas dos aviões
+        dados_aviao->portoesList = &recursos.portoes;
+        dados_aviao->mutex_avioes = &recursos.mutex_avioes;
+        dados_aviao->contencao_avioes = &recursos.contencao_avioes;
+        dados_aviao->avioes_pendentes = &recursos.avioes_pendentes;
+        dados_aviao->metricas = &recursos.metricas;
+        dados_aviao->rastro = &recursos.rastro;
+        dados_aviao->pool = &pool;
+        dados_aviao->atraso_inicio_ms = chegada_ms;
+        return dados_aviao;
+    }
+
+    Configuracao config;
+    RecursosCompartilhados& recursos;
+    PoolTarefas& pool;
+    std::unique_ptr<FonteChegadas> fonte;
+    bool ha_proxima;
+    int64_t proxima_ms;     // Chegada seguinte, desde o início da simulação
+    int proximo_id;
+};
+
+} // namespace
+
+void iniciarSimulacao(const Configuracao& config, RecursosCompartilhados& recursos, PoolTarefas& pool) {
+    // Inicializar alocadores: o avião estacionado é retomado no pool com a
+    // pista, a via ou o portão recebido
+    PoolTarefas* pool_avioes = &pool;
+    AlocadorRecursos::Concessao retomar = [pool_avioes](void* solicitante, int recurso) {
+        AviaoData* dados_aviao = static_cast<AviaoData*>(solicitante);
+        dados_aviao->recurso_concedido = recurso;
+        pool_avioes->retomar(dados_aviao);
+    };
+    recursos.alocador_pistas.reset(new AlocadorRecursos(static_cast<int>(recursos.pistas.size()), retomar,
+                                                        criarPolitica(config.politica_pistas)));
+    std::cout << "Alocador inicializado com " << recursos.pistas.size() << " pistas (política "
+              << recursos.alocador_pistas->nomePolitica() << ").\n";
+    if(!recursos.portoes.empty()) {
+        recursos.alocador_portoes.reset(new AlocadorRecursos(static_cast<int>(recursos.portoes.size()), retomar,
+                                                             criarPolitica(config.politica_pistas)));
+        if(config.num_vias_taxi > 0) {
+            recursos.alocador_vias.reset(new AlocadorRecursos(config.num_vias_taxi, retomar,
+                                                              criarPolitica(config.politica_pistas)));
+        }
+        std::cout << recursos.portoes.size() << " portões e "
+                  << (config.num_vias_taxi > 0 ? std::to_string(config.num_vias_taxi) : std::string("sem limite de"))
+                  << " vias de táxi.\n";
+    }
+
+    // Tick central: move os aviões em voo e publica os quadros lidos pelo renderer
+    pool.agendar(new TickSimulacao(recursos.avioes, recursos.frota, recursos.mutex_avioes,
+                                   recursos.contencao_avioes, *recursos.alocador_pistas,
+                                   recursos.quadros, recursos.metricas, pool, recursos.gravacao), 0);
+
+    // Os aviões vêm da fonte de chegadas, criados pouco antes de entrarem no céu
+    recursos.inicio_ms = recursos.relogio.agoraMs();
+    std::string erro;
+    std::unique_ptr<FonteChegadas> fonte = criarFonteChegadas(config, 0, erro);
+    if(!fonte) {
+        std::cerr << erro << std::endl;
+        recursos.avioes_pendentes = 0;
+        return;
+    }
+    recursos.avioes_pendentes = 1;      // A própria fonte, até se esgotar
+    pool.agendar(new TarefaChegadas(config, recursos, pool, std::move(fonte)), 0);
+}
+
+void interromperSimulacao(RecursosCompartilhados& recursos, PoolTarefas& pool) {
+    pool.cancelar();
+    for(AlocadorRecursos* alocador : {recursos.alocador_pistas.get(), recursos.alocador_vias.get(),
+                                      recursos.alocador_portoes.get()}) {
+        if(!alocador) {
+            continue;
+        }
+        for(void* solicitante : alocador->cancelarEspera()) {
+            pool.descartar(static_cast<AviaoData*>(solicitante));
+        }
+    }
+}
+
+void concluirMetricas(RecursosCompartilhados& recursos) {
+    if(!recursos.alocador_pistas) {
+        return;
+    }
+    recursos.metricas.definirUsoPistas(recursos.alocador_pistas->usoAcumulado(),
+                                       recursos.relogio.agoraMs() - recursos.inicio_ms);
+    recursos.metricas.registrarContencao("mutex_avioes", &recursos.contencao_avioes);
+    recursos.metricas.registrarContencao("alocador_pistas", &recursos.alocador_pistas->contencao());
+    if(recursos.alocador_portoes) {
+        recursos.metricas.registrarContencao("alocador_portoes", &recursos.alocador_portoes->contencao());
+    }
+    if(recursos.alocador_vias) {
+        recursos.metricas.registrarContencao("alocador_vias", &recursos.alocador_vias->contencao());
+    }
+}
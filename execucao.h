@@ -0,0 +1,63 @@
+#ifndef EXECUCAO_H
+#define EXECUCAO_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "aviao.h"
+#include "alocador.h"
+#include "buffer_triplo.h"
+#include "chegadas.h"
+#include "configuracao.h"
+#include "contencao.h"
+#include "frota.h"
+#include "gravacao.h"
+#include "metricas.h"
+#include "pista.h"
+#include "pool_tarefas.h"
+#include "quadro.h"
+#include "rastro.h"
+#include "relogio.h"
+
+// Estrutura para gerenciar recursos compartilhados. Vale por uma execução: a
+// janela cria uma nova a cada simulação, com o mesmo relógio e o mesmo pool.
+struct RecursosCompartilhados {
+    explicit RecursosCompartilhados(RelogioSimulacao& relogio) : relogio(relogio) {}
+
+    RelogioSimulacao& relogio; // Relógio do pool (escala ajustável durante a execução)
+    RegistroAvioes avioes;
+    FrotaAerea frota;      // Aviões em voo, movidos pelo tick central
+    std::vector<Runway> pistas; // Lista de pistas
+    std::vector<Runway> portoes; // Portões de desembarque (vazio: desembarque na pista)
+    std::mutex mutex_avioes;
+    std::unique_ptr<AlocadorRecursos> alocador_pistas; // Entrega as pistas aos aviões
+    std::unique_ptr<AlocadorRecursos> alocador_vias;   // Vias de táxi (só com portões e vias limitadas)
+    std::unique_ptr<AlocadorRecursos> alocador_portoes;
+    ContadorContencao contencao_avioes;           // Espera dos escritores por mutex_avioes
+    BufferTriplo<QuadroSimulacao> quadros;        // Quadros publicados para o renderer
+    std::atomic<int> avioes_pendentes{0};         // Aviões que ainda não concluíram (+1 até a fonte se esgotar)
+    ArenaAvioes arena_avioes;                     // Dados dos aviões, reciclados quando eles decolam
+    RegistroMetricas metricas;                    // Latências, fila, ocupação e contenção
+    int64_t inicio_ms = 0;                        // Início da simulação (para a ocupação das pistas)
+    Rastreador rastro;                            // Rastro binário dos aviões (inativo até ser aberto)
+    GravadorSimulacao gravacao;                   // Quadros gravados para reprodução (inativo até ser aberto)
+};
+
+// Inicia a simulação com threads: cria os alocadores de pistas, vias e
+// portões, agenda o tick central e a tarefa que cria os aviões da fonte de
+// chegadas conforme eles chegam. As pistas e os portões já devem estar em
+// recursos.pistas e recursos.portoes e o pool deve usar recursos.relogio. Usada pela janela e pelo benchmark.
+void iniciarSimulacao(const Configuracao& config, RecursosCompartilhados& recursos, PoolTarefas& pool);
+
+// Interrompe a simulação em andamento: cancela as esperas do pool e descarta
+// os aviões estacionados nas filas dos alocadores. Volta assim que os passos em
+// andamento terminam; depois disso os recursos podem ser destruídos e o pool
+// reaproveitado.
+void interromperSimulacao(RecursosCompartilhados& recursos, PoolTarefas& pool);
+
+// Passa às métricas a ocupação das pistas e os contadores de contenção ao final
+void concluirMetricas(RecursosCompartilhados& recursos);
+
+#endif
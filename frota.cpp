@@ -0,0 +1,142 @@
+#include "frota.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Adiciona um avião em voo
+void FrotaAerea::adicionar(HandleSlot handle, float pos_x, float pos_y, bool paraDireita) {
+    if(handle.indice >= indice_por_slot.size()) {
+        indice_por_slot.resize(handle.indice + 1, UINT32_MAX);
+    }
+    indice_por_slot[handle.indice] = static_cast<uint32_t>(x.size());
+    x.push_back(pos_x);
+    y.push_back(pos_y);
+    direcao.push_back(paraDireita ? 1.0f : -1.0f);
+    handles.push_back(handle);
+}
+
+// Remove o avião trocando-o com o último dos arrays
+void FrotaAerea::remover(HandleSlot handle) {
+    if(handle.indice >= indice_por_slot.size() || indice_por_slot[handle.indice] == UINT32_MAX) {
+        return;
+    }
+    uint32_t i = indice_por_slot[handle.indice];
+    uint32_t ultimo = static_cast<uint32_t>(x.size() - 1);
+    if(i != ultimo) {
+        x[i] = x[ultimo];
+        y[i] = y[ultimo];
+        direcao[i] = direcao[ultimo];
+        handles[i] = handles[ultimo];
+        indice_por_slot[handles[i].indice] = i;
+    }
+    x.pop_back();
+    y.pop_back();
+    direcao.pop_back();
+    handles.pop_back();
+    indice_por_slot[handle.indice] = UINT32_MAX;
+}
+
+void FrotaAerea::avancar() {
+    avancarPosicoes(x.data(), direcao.data(), x.size());
+}
+
+void FrotaAerea::avancar(int64_t passos) {
+    if(passos == 1) {
+        avancar();
+        return;
+    }
+    for(size_t i = 0; i < x.size(); ++i) {
+        avancarPassos(x[i], direcao[i], passos);
+    }
+}
+
+namespace {
+
+// Passos até a próxima inversão: o primeiro em que a posição alcança o limite
+// para onde o avião vai (pelo menos um, como em avancarPosicoesEscalar)
+int64_t passosAteInverter(float x, float direcao) {
+    float distancia = direcao > 0.0f ? LIMITE_DIREITO - x : x - LIMITE_ESQUERDO;
+    return std::max<int64_t>(1, static_cast<int64_t>(std::ceil(distancia / VELOCIDADE_MOVIMENTO)));
+}
+
+} // namespace
+
+// Entre duas inversões o movimento é linear. Um avião que surgiu além do limite
+// inverte logo no primeiro passo; a partir da segunda inversão, que é sempre no
+// limite, cada ida e volta tem o mesmo número de passos, então as voltas
+// completas são descartadas e sobram poucos trechos. As posições são múltiplos
+// inteiros do passo somados à inicial, então o resultado é exatamente o dos
+// passos um a um.
+void avancarPassos(float& x, float& direcao, int64_t passos) {
+    int inversoes = 0;
+    while(passos > 0) {
+        int64_t ate_inverter = passosAteInverter(x, direcao);
+        if(passos < ate_inverter) {
+            x += static_cast<float>(passos) * VELOCIDADE_MOVIMENTO * direcao;
+            return;
+        }
+        x += static_cast<float>(ate_inverter) * VELOCIDADE_MOVIMENTO * direcao;
+        direcao = -direcao;
+        passos -= ate_inverter;
+        if(++inversoes == 2) {
+            int64_t ida = passosAteInverter(x, direcao);
+            float x_volta = x + static_cast<float>(ida) * VELOCIDADE_MOVIMENTO * direcao;
+            passos %= ida + passosAteInverter(x_volta, -direcao);
+        }
+    }
+}
+
+// Versão escalar: os ternários viram seleções (cmov/blend), sem desvios dependentes dos dados
+void avancarPosicoesEscalar(float* x, float* direcao, size_t n) {
+    for(size_t i = 0; i < n; ++i) {
+        float nx = x[i] + VELOCIDADE_MOVIMENTO * direcao[i];
+        float d = direcao[i];
+        d = nx >= LIMITE_DIREITO ? -1.0f : d;   // Muda direção para esquerda
+        d = nx <= LIMITE_ESQUERDO ? 1.0f : d;   // Muda direção para direita
+        x[i] = nx;
+        direcao[i] = d;
+    }
+}
+
+// Versão vetorizada: 8 aviões por instrução com AVX, 4 com SSE2, restante escalar
+void avancarPosicoes(float* x, float* direcao, size_t n) {
+    size_t i = 0;
+#if defined(__AVX__)
+    const __m256 velocidade = _mm256_set1_ps(VELOCIDADE_MOVIMENTO);
+    const __m256 limite_dir = _mm256_set1_ps(LIMITE_DIREITO);
+    const __m256 limite_esq = _mm256_set1_ps(LIMITE_ESQUERDO);
+    const __m256 para_esquerda = _mm256_set1_ps(-1.0f);
+    const __m256 para_direita = _mm256_set1_ps(1.0f);
+    for(; i + 8 <= n; i += 8) {
+        __m256 d = _mm256_loadu_ps(direcao + i);
+        __m256 nx = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(velocidade, d));
+        d = _mm256_blendv_ps(d, para_esquerda, _mm256_cmp_ps(nx, limite_dir, _CMP_GE_OQ));
+        d = _mm256_blendv_ps(d, para_direita, _mm256_cmp_ps(nx, limite_esq, _CMP_LE_OQ));
+        _mm256_storeu_ps(x + i, nx);
+        _mm256_storeu_ps(direcao + i, d);
+    }
+#elif defined(__SSE2__)
+    const __m128 velocidade = _mm_set1_ps(VELOCIDADE_MOVIMENTO);
+    const __m128 limite_dir = _mm_set1_ps(LIMITE_DIREITO);
+    const __m128 limite_esq = _mm_set1_ps(LIMITE_ESQUERDO);
+    const __m128 para_esquerda = _mm_set1_ps(-1.0f);
+    const __m128 para_direita = _mm_set1_ps(1.0f);
+    for(; i + 4 <= n; i += 4) {
+        __m128 d = _mm_loadu_ps(direcao + i);
+        __m128 nx = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(velocidade, d));
+        // Seleção por máscara: (máscara & novo) | (~máscara & antigo)
+        __m128 m = _mm_cmpge_ps(nx, limite_dir);
+        d = _mm_or_ps(_mm_and_ps(m, para_esquerda), _mm_andnot_ps(m, d));
+        m = _mm_cmple_ps(nx, limite_esq);
+        d = _mm_or_ps(_mm_and_ps(m, para_direita), _mm_andnot_ps(m, d));
+        _mm_storeu_ps(x + i, nx);
+        _mm_storeu_ps(direcao + i, d);
+    }
+#endif
+    avancarPosicoesEscalar(x + i, direcao + i, n - i);
+}
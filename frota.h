@@ -0,0 +1,52 @@
+#ifndef FROTA_H
+#define FROTA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "mapa_slots.h"
+
+// Define limites da tela para o movimento do avião
+constexpr float LIMITE_ESQUERDO = 50.0f;
+constexpr float LIMITE_DIREITO = 750.0f; // Supondo LARGURA_JANELA = 800
+constexpr float VELOCIDADE_MOVIMENTO = 1.0f; // Pixels por atualização
+
+// Aviões em voo em estrutura de arrays (x, y e direção contíguos), avançados
+// todos juntos a cada tick. O índice de cada avião muda com as remoções, então
+// o acesso de fora é sempre pelo handle do registro.
+class FrotaAerea {
+public:
+    void adicionar(HandleSlot handle, float x, float y, bool movendoParaDireita);
+    void remover(HandleSlot handle);
+
+    // Avança todos os aviões um passo, invertendo a direção nos limites sem desvios
+    void avancar();
+
+    // Avança `passos` passos de uma vez, com o mesmo resultado de chamar
+    // avancar() esse número de vezes mas em tempo que não depende dele
+    void avancar(int64_t passos);
+
+    size_t tamanho() const { return x.size(); }
+    float posicaoX(size_t i) const { return x[i]; }
+    float posicaoY(size_t i) const { return y[i]; }
+    bool movendoParaDireita(size_t i) const { return direcao[i] > 0.0f; }
+    HandleSlot handle(size_t i) const { return handles[i]; }
+    const float* dadosX() const { return x.data(); }
+    const float* dadosY() const { return y.data(); }
+
+private:
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> direcao;             // +1 para a direita, -1 para a esquerda
+    std::vector<HandleSlot> handles;
+    std::vector<uint32_t> indice_por_slot;  // Slot do registro -> índice nos arrays
+};
+
+// Avança um intervalo dos arrays; a versão escalar fica exposta para comparação com a vetorizada
+void avancarPosicoes(float* x, float* direcao, size_t n);
+void avancarPosicoesEscalar(float* x, float* direcao, size_t n);
+
+// Avança um avião vários passos em forma fechada
+void avancarPassos(float& x, float& direcao, int64_t passos);
+
+#endif
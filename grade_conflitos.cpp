@@ -0,0 +1,214 @@
+#include "grade_conflitos.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Um par está a menos de `distancia` se dx² + dy² < distancia², a mesma conta da
+// força bruta (comparar |dx| com sqrt(distancia² - dy²) erraria por arredondamento
+// nos pares da borda). Com dy fixo a condição só depende de |dx|, o que permite os dois ponteiros.
+inline bool perto(float dx, float dy2, float distancia) {
+    return dx * dx + dy2 < distancia * distancia;
+}
+
+// Pares (i < j) de uma faixa ordenada por x a menos de `distancia`
+template <class Ponto>
+uint64_t paresNaFaixa(const Ponto* p, uint32_t n, float dy2, float distancia) {
+    uint64_t pares = 0;
+    uint32_t fim = 0;
+    for(uint32_t i = 0; i < n; ++i) {
+        fim = std::max(fim, i + 1);
+        while(fim < n && perto(p[fim].x - p[i].x, dy2, distancia)) {
+            ++fim;
+        }
+        pares += fim - i - 1;
+    }
+    return pares;
+}
+
+// Pares (a, b) de duas faixas ordenadas por x a menos de `distancia`. A janela de b
+// perto de a.x só avança: [inicio, fim) com |b.x - a.x| dentro da distância
+template <class Ponto>
+uint64_t paresEntreFaixas(const Ponto* a, uint32_t na, const Ponto* b, uint32_t nb, float dy2, float distancia) {
+    uint64_t pares = 0;
+    uint32_t inicio = 0, fim = 0;
+    for(uint32_t i = 0; i < na; ++i) {
+        while(inicio < nb && b[inicio].x < a[i].x && !perto(a[i].x - b[inicio].x, dy2, distancia)) {
+            ++inicio;
+        }
+        fim = std::max(fim, inicio);
+        while(fim < nb && perto(b[fim].x - a[i].x, dy2, distancia)) {
+            ++fim;
+        }
+        pares += fim - inicio;
+    }
+    return pares;
+}
+
+// Bits de um float como inteiro sem sinal na mesma ordem dos valores (negativos incluídos)
+inline uint32_t chaveOrdenada(float valor) {
+    uint32_t bits;
+    std::memcpy(&bits, &valor, sizeof(bits));
+    return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+}
+
+inline float valorDaChave(uint32_t chave) {
+    uint32_t bits = chave & 0x80000000u ? chave & 0x7FFFFFFFu : ~chave;
+    float valor;
+    std::memcpy(&valor, &bits, sizeof(valor));
+    return valor;
+}
+
+} // namespace
+
+void GradeConflitos::construir(const float* x, const float* y, size_t n) {
+    pontos.resize(n);
+    inicio_faixa.clear();
+    primeira_faixa.clear();
+    if(n == 0) {
+        colunas = linhas = 0;
+        inicio_celula.assign(1, 0);
+        primeira_faixa.assign(1, 0);
+        inicio_faixa.assign(1, 0);
+        return;
+    }
+
+    float min_x = x[0], max_x = x[0], min_y = y[0], max_y = y[0];
+    for(size_t i = 1; i < n; ++i) {
+        min_x = std::min(min_x, x[i]);
+        max_x = std::max(max_x, x[i]);
+        min_y = std::min(min_y, y[i]);
+        max_y = std::max(max_y, y[i]);
+    }
+
+    // Células de lado DISTANCIA_ALERTA; se os aviões estiverem muito espalhados,
+    // o lado cresce para o número de células não passar de ~4 por avião
+    origem_x = min_x;
+    origem_y = min_y;
+    lado = DISTANCIA_ALERTA;
+    double limite_celulas = 4.0 * n + 64.0;
+    double celulas = (std::floor((max_x - min_x) / lado) + 1.0) * (std::floor((max_y - min_y) / lado) + 1.0);
+    if(celulas > limite_celulas) {
+        lado *= static_cast<float>(std::sqrt(celulas / limite_celulas)) + 1.0f;
+    }
+    colunas = static_cast<int>((max_x - min_x) / lado) + 1;
+    linhas = static_cast<int>((max_y - min_y) / lado) + 1;
+    size_t num_celulas = static_cast<size_t>(colunas) * linhas;
+
+    // Counting sort das posições por célula
+    inicio_celula.assign(num_celulas + 1, 0);
+    celula_do_ponto.resize(n);
+    for(size_t i = 0; i < n; ++i) {
+        int cx = std::min(colunas - 1, static_cast<int>((x[i] - origem_x) / lado));
+        int cy = std::min(linhas - 1, static_cast<int>((y[i] - origem_y) / lado));
+        uint32_t celula = static_cast<uint32_t>(cy * colunas + cx);
+        celula_do_ponto[i] = celula;
+        inicio_celula[celula + 1]++;
+    }
+    for(size_t c = 0; c < num_celulas; ++c) {
+        inicio_celula[c + 1] += inicio_celula[c];
+    }
+    // inicio_celula serve de cursor de escrita e depois é deslocado de volta.
+    // Cada posição vira uma chave inteira (altura, x) que ordena como o par de floats
+    chaves.resize(n);
+    for(size_t i = 0; i < n; ++i) {
+        chaves[inicio_celula[celula_do_ponto[i]]++] =
+            (static_cast<uint64_t>(chaveOrdenada(y[i])) << 32) | chaveOrdenada(x[i]);
+    }
+    for(size_t c = num_celulas; c > 0; --c) {
+        inicio_celula[c] = inicio_celula[c - 1];
+    }
+    inicio_celula[0] = 0;
+
+    // Ordena cada célula por (altura, x) e marca o início de cada faixa de mesma altura
+    primeira_faixa.reserve(num_celulas + 1);
+    for(size_t c = 0; c < num_celulas; ++c) {
+        primeira_faixa.push_back(static_cast<uint32_t>(inicio_faixa.size()));
+        uint32_t inicio = inicio_celula[c], fim = inicio_celula[c + 1];
+        std::sort(chaves.begin() + inicio, chaves.begin() + fim);
+        for(uint32_t i = inicio; i < fim; ++i) {
+            if(i == inicio || (chaves[i] >> 32) != (chaves[i - 1] >> 32)) {
+                inicio_faixa.push_back(i);
+            }
+            pontos[i] = {valorDaChave(static_cast<uint32_t>(chaves[i] >> 32)),
+                         valorDaChave(static_cast<uint32_t>(chaves[i]))};
+        }
+    }
+    primeira_faixa.push_back(static_cast<uint32_t>(inicio_faixa.size()));
+    inicio_faixa.push_back(static_cast<uint32_t>(n));
+}
+
+// Soma os pares entre duas faixas (ou dentro de uma) a menos das duas distâncias
+void GradeConflitos::contarPares(uint32_t a_inicio, uint32_t a_fim, uint32_t b_inicio, uint32_t b_fim,
+                                 bool mesma_faixa, ContagemConflitos& contagem) const {
+    float dy = pontos[a_inicio].y - pontos[b_inicio].y;
+    float dy2 = dy * dy;
+    if(dy2 >= DISTANCIA_ALERTA * DISTANCIA_ALERTA) {
+        return;
+    }
+    const Ponto* a = pontos.data() + a_inicio;
+    const Ponto* b = pontos.data() + b_inicio;
+    uint32_t na = a_fim - a_inicio, nb = b_fim - b_inicio;
+    uint64_t alerta = mesma_faixa ? paresNaFaixa(a, na, dy2, DISTANCIA_ALERTA)
+                                  : paresEntreFaixas(a, na, b, nb, dy2, DISTANCIA_ALERTA);
+    uint64_t violacoes = dy2 >= SEPARACAO_MINIMA * SEPARACAO_MINIMA ? 0
+                       : mesma_faixa ? paresNaFaixa(a, na, dy2, SEPARACAO_MINIMA)
+                                     : paresEntreFaixas(a, na, b, nb, dy2, SEPARACAO_MINIMA);
+    contagem.violacoes += violacoes;
+    contagem.quase_colisoes += alerta - violacoes;
+}
+
+// Cada par de células vizinhas é visitado uma vez: a própria célula e as
+// vizinhas à direita e na linha de baixo
+ContagemConflitos GradeConflitos::detectar() const {
+    static const int VIZINHAS[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+    ContagemConflitos contagem;
+    for(int cy = 0; cy < linhas; ++cy) {
+        for(int cx = 0; cx < colunas; ++cx) {
+            uint32_t c = static_cast<uint32_t>(cy * colunas + cx);
+            uint32_t faixas_c = primeira_faixa[c], fim_faixas_c = primeira_faixa[c + 1];
+            if(faixas_c == fim_faixas_c) {
+                continue;
+            }
+
+            for(uint32_t fa = faixas_c; fa < fim_faixas_c; ++fa) {
+                for(uint32_t fb = fa; fb < fim_faixas_c; ++fb) {
+                    contarPares(inicio_faixa[fa], inicio_faixa[fa + 1], inicio_faixa[fb], inicio_faixa[fb + 1],
+                                fa == fb, contagem);
+                }
+            }
+
+            for(const auto& deslocamento : VIZINHAS) {
+                int vx = cx + deslocamento[0], vy = cy + deslocamento[1];
+                if(vx < 0 || vx >= colunas || vy >= linhas) {
+                    continue;
+                }
+                uint32_t v = static_cast<uint32_t>(vy * colunas + vx);
+                for(uint32_t fa = faixas_c; fa < fim_faixas_c; ++fa) {
+                    for(uint32_t fb = primeira_faixa[v]; fb < primeira_faixa[v + 1]; ++fb) {
+                        contarPares(inicio_faixa[fa], inicio_faixa[fa + 1], inicio_faixa[fb], inicio_faixa[fb + 1],
+                                    false, contagem);
+                    }
+                }
+            }
+        }
+    }
+    return contagem;
+}
+
+ContagemConflitos contarConflitosForcaBruta(const float* x, const float* y, size_t n) {
+    ContagemConflitos contagem;
+    for(size_t i = 0; i < n; ++i) {
+        for(size_t j = i + 1; j < n; ++j) {
+            float dx = x[i] - x[j], dy = y[i] - y[j];
+            float d2 = dx * dx + dy * dy;
+            if(d2 < SEPARACAO_MINIMA * SEPARACAO_MINIMA) {
+                contagem.violacoes++;
+            } else if(d2 < DISTANCIA_ALERTA * DISTANCIA_ALERTA) {
+                contagem.quase_colisoes++;
+            }
+        }
+    }
+    return contagem;
+}
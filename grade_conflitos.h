@@ -0,0 +1,60 @@
+#ifndef GRADE_CONFLITOS_H
+#define GRADE_CONFLITOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Distâncias entre aviões em voo (pixels)
+constexpr float SEPARACAO_MINIMA = 15.0f;  // Abaixo disso os triângulos se sobrepõem: violação
+constexpr float DISTANCIA_ALERTA = 30.0f;  // Abaixo disso (e acima da mínima): quase colisão
+
+// Pares de aviões em conflito em um tick
+struct ContagemConflitos {
+    uint64_t violacoes = 0;         // Pares a menos de SEPARACAO_MINIMA
+    uint64_t quase_colisoes = 0;    // Pares entre SEPARACAO_MINIMA e DISTANCIA_ALERTA
+};
+
+// Grade uniforme sobre as posições dos aviões em voo, com células de lado
+// DISTANCIA_ALERTA: um par em conflito está na mesma célula ou em células
+// vizinhas. A grade é refeita a cada tick por counting sort (O(N + células)),
+// reaproveitando os buffers.
+//
+// Dentro de cada célula os aviões ficam agrupados em faixas de mesma altura e
+// ordenados por x. Entre duas faixas a diferença de altura é fixa, então os
+// pares a menos de uma distância são contados com dois ponteiros, sem listar
+// cada par: com as poucas altitudes de voo da simulação o custo é linear no
+// número de aviões mesmo com milhares deles por célula.
+class GradeConflitos {
+public:
+    // Copia as posições para a grade. Chamada com os arrays estáveis (sob o mutex dos aviões)
+    void construir(const float* x, const float* y, size_t n);
+
+    // Conta os pares em conflito da última construção; não depende mais dos arrays originais
+    ContagemConflitos detectar() const;
+
+private:
+    struct Ponto {
+        float y, x;     // Ordenados por altura e depois por x dentro da célula
+    };
+
+    void contarPares(uint32_t a_inicio, uint32_t a_fim, uint32_t b_inicio, uint32_t b_fim, bool mesma_faixa,
+                     ContagemConflitos& contagem) const;
+
+    float origem_x = 0.0f;
+    float origem_y = 0.0f;
+    float lado = DISTANCIA_ALERTA;
+    int colunas = 0;
+    int linhas = 0;
+    std::vector<Ponto> pontos;              // Posições ordenadas por célula
+    std::vector<uint64_t> chaves;           // Mesmas posições como chaves inteiras, usadas na ordenação
+    std::vector<uint32_t> celula_do_ponto;  // Célula de cada posição de entrada (auxiliar do counting sort)
+    std::vector<uint32_t> inicio_celula;    // Primeira posição de cada célula (+ sentinela)
+    std::vector<uint32_t> inicio_faixa;     // Primeira posição de cada faixa (+ sentinela)
+    std::vector<uint32_t> primeira_faixa;   // Primeira faixa de cada célula (+ sentinela)
+};
+
+// Contagem por força bruta (O(N²)), exposta para conferir a grade
+ContagemConflitos contarConflitosForcaBruta(const float* x, const float* y, size_t n);
+
+#endif
@@ -0,0 +1,733 @@
+#include "gravacao.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "configuracao.h"
+#include "frota.h"
+
+// Sem mmap no Windows: lá abrir a gravação ou a reprodução falha e o resto segue igual
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint32_t VERSAO_GRAVACAO = 2;
+
+// Tipos de registro; 0 é o espaço ainda não escrito no fim de uma gravação interrompida
+constexpr uint8_t REGISTRO_CHAVE = 1;
+constexpr uint8_t REGISTRO_DELTA = 2;
+
+// Campos presentes em um avião alterado
+constexpr uint8_t ALTEROU_X = 1;
+constexpr uint8_t ALTEROU_Y = 2;
+constexpr uint8_t ALTEROU_FASE = 4;
+
+// Deslocamento por passo de um avião em voo, na escala das posições gravadas
+const int64_t PASSO_X = std::lround(VELOCIDADE_MOVIMENTO * ESCALA_POSICAO);
+
+void escreverVarint(std::vector<uint8_t>& saida, uint64_t valor) {
+    while(valor >= 0x80) {
+        saida.push_back(static_cast<uint8_t>(valor | 0x80));
+        valor >>= 7;
+    }
+    saida.push_back(static_cast<uint8_t>(valor));
+}
+
+void escreverZigZag(std::vector<uint8_t>& saida, int64_t valor) {
+    escreverVarint(saida, (static_cast<uint64_t>(valor) << 1) ^ static_cast<uint64_t>(valor >> 63));
+}
+
+// Leitura com limite: qualquer byte além do fim invalida o leitor
+struct Leitor {
+    const uint8_t* atual;
+    const uint8_t* fim;
+    bool ok = true;
+
+    uint64_t varint() {
+        uint64_t valor = 0;
+        for(int deslocamento = 0; deslocamento < 64; deslocamento += 7) {
+            if(atual >= fim) {
+                break;
+            }
+            uint8_t byte = *atual++;
+            valor |= static_cast<uint64_t>(byte & 0x7f) << deslocamento;
+            if(!(byte & 0x80)) {
+                return valor;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+
+    int64_t zigzag() {
+        uint64_t valor = varint();
+        return static_cast<int64_t>(valor >> 1) ^ -static_cast<int64_t>(valor & 1);
+    }
+
+    uint8_t byte() {
+        if(atual >= fim) {
+            ok = false;
+            return 0;
+        }
+        return *atual++;
+    }
+};
+
+AviaoGravado gravarAviao(const Plane& aviao) {
+    AviaoGravado gravado;
+    gravado.id = static_cast<uint32_t>(aviao.id);
+    gravado.x = static_cast<int32_t>(std::lround(aviao.x * ESCALA_POSICAO));
+    gravado.y = static_cast<int32_t>(std::lround(aviao.y * ESCALA_POSICAO));
+    if(!aviao.aterrissou) {
+        gravado.fase = aviao.movendoParaDireita ? FASE_VOANDO_DIREITA : FASE_VOANDO_ESQUERDA;
+    } else {
+        // Em solo a cor distingue o avião parado (vermelho) do que está decolando (verde)
+        gravado.fase = aviao.cor.r == 0 && aviao.cor.g == 255 ? FASE_DECOLANDO : FASE_EM_SOLO;
+    }
+    gravado.pista = static_cast<uint16_t>(std::max(0, aviao.pistaAtribuida));
+    return gravado;
+}
+
+Plane reproduzirAviao(const AviaoGravado& gravado) {
+    Plane aviao;
+    aviao.id = static_cast<int>(gravado.id);
+    aviao.x = static_cast<float>(gravado.x) / ESCALA_POSICAO;
+    aviao.y = static_cast<float>(gravado.y) / ESCALA_POSICAO;
+    aviao.movendoParaDireita = gravado.fase == FASE_VOANDO_DIREITA;
+    aviao.aterrissou = gravado.fase == FASE_EM_SOLO || gravado.fase == FASE_DECOLANDO;
+    if(gravado.fase == FASE_EM_SOLO) {
+        aviao.cor = {255, 0, 0, 255};
+    } else if(gravado.fase == FASE_DECOLANDO) {
+        aviao.cor = {0, 255, 0, 255};
+    } else {
+        aviao.cor = {255, 255, 255, 255};
+    }
+    aviao.pistaAtribuida = gravado.pista;
+    return aviao;
+}
+
+// Posição x esperada depois de dt_ms: em voo, um passo por ATRASO_MOVIMENTO_MS
+// na direção atual; em solo, parado. Só o que fugir disso é gravado.
+int32_t xPrevisto(const AviaoGravado& aviao, int64_t dt_ms) {
+    int64_t passos = dt_ms / ATRASO_MOVIMENTO_MS;
+    if(aviao.fase == FASE_VOANDO_DIREITA) {
+        return static_cast<int32_t>(aviao.x + passos * PASSO_X);
+    }
+    if(aviao.fase == FASE_VOANDO_ESQUERDA) {
+        return static_cast<int32_t>(aviao.x - passos * PASSO_X);
+    }
+    return aviao.x;
+}
+
+void escreverAviao(std::vector<uint8_t>& saida, const AviaoGravado& aviao, uint32_t id_anterior) {
+    escreverVarint(saida, aviao.id - id_anterior);
+    escreverZigZag(saida, aviao.x);
+    escreverZigZag(saida, aviao.y);
+    saida.push_back(aviao.fase);
+    escreverVarint(saida, aviao.pista);
+}
+
+AviaoGravado lerAviao(Leitor& leitor, uint32_t id_anterior) {
+    AviaoGravado aviao;
+    aviao.id = id_anterior + static_cast<uint32_t>(leitor.varint());
+    aviao.x = static_cast<int32_t>(leitor.zigzag());
+    aviao.y = static_cast<int32_t>(leitor.zigzag());
+    aviao.fase = leitor.byte();
+    aviao.pista = static_cast<uint16_t>(leitor.varint());
+    return aviao;
+}
+
+bool porId(const AviaoGravado& a, const AviaoGravado& b) {
+    return a.id < b.id;
+}
+
+#ifndef _WIN32
+// Reserva o espaço no disco antes de mapeá-lo: sem espaço, a falha aparece
+// aqui e não como SIGBUS na cópia. O macOS não tem posix_fallocate; lá o
+// arquivo só cresce (esparso).
+bool reservarEspaco(int descritor, uint64_t inicio, size_t tamanho) {
+#ifdef __APPLE__
+    return ::ftruncate(descritor, static_cast<off_t>(inicio + tamanho)) == 0;
+#else
+    return ::posix_fallocate(descritor, static_cast<off_t>(inicio), static_cast<off_t>(tamanho)) == 0;
+#endif
+}
+#endif
+
+} // namespace
+
+LogMapeado::LogMapeado() : descritor(-1), janela(nullptr), inicio_janela(0), escritos(0), falhou(false) {}
+
+LogMapeado::~LogMapeado() {
+    fechar();
+}
+
+bool LogMapeado::abrir(const std::string& caminho) {
+    fechar();
+#ifdef _WIN32
+    (void)caminho;
+    return false;
+#else
+    descritor = ::open(caminho.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(descritor < 0) {
+        return false;
+    }
+    escritos = 0;
+    falhou = false;
+    if(!mapearJanela(0)) {
+        ::close(descritor);
+        descritor = -1;
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool LogMapeado::mapearJanela(uint64_t inicio) {
+#ifdef _WIN32
+    (void)inicio;
+    return false;
+#else
+    if(janela) {
+        ::munmap(janela, TAMANHO_JANELA);
+        janela = nullptr;
+    }
+    if(!reservarEspaco(descritor, inicio, TAMANHO_JANELA)) {
+        return false;
+    }
+    void* mapa = ::mmap(nullptr, TAMANHO_JANELA, PROT_READ | PROT_WRITE, MAP_SHARED, descritor,
+                        static_cast<off_t>(inicio));
+    if(mapa == MAP_FAILED) {
+        return false;
+    }
+    janela = static_cast<char*>(mapa);
+    inicio_janela = inicio;
+    return true;
+#endif
+}
+
+void LogMapeado::anexar(const void* dados, size_t tamanho) {
+    const char* origem = static_cast<const char*>(dados);
+    while(tamanho > 0 && !falhou) {
+        if(escritos == inicio_janela + TAMANHO_JANELA && !mapearJanela(escritos)) {
+            falhou = true;
+            return;
+        }
+        size_t posicao = static_cast<size_t>(escritos - inicio_janela);
+        size_t n = std::min(tamanho, TAMANHO_JANELA - posicao);
+        std::memcpy(janela + posicao, origem, n);
+        escritos += n;
+        origem += n;
+        tamanho -= n;
+    }
+}
+
+bool LogMapeado::sobrescrever(uint64_t posicao, const void* dados, size_t tamanho) {
+    if(descritor < 0 || posicao + tamanho > escritos) {
+        return false;
+    }
+#ifdef _WIN32
+    (void)dados;
+    return false;
+#else
+    return ::pwrite(descritor, dados, tamanho, static_cast<off_t>(posicao)) == static_cast<ssize_t>(tamanho);
+#endif
+}
+
+bool LogMapeado::fechar() {
+    if(descritor < 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return false;
+#else
+    if(janela) {
+        ::munmap(janela, TAMANHO_JANELA);
+        janela = nullptr;
+    }
+    bool ok = !falhou && ::ftruncate(descritor, static_cast<off_t>(escritos)) == 0;
+    ok = ::close(descritor) == 0 && ok;
+    descritor = -1;
+    return ok;
+#endif
+}
+
+GravadorSimulacao::GravadorSimulacao() : cabecalho(), origem_ms(0), tempo_anterior_ms(0), total_quadros(0) {}
+
+bool GravadorSimulacao::abrir(const std::string& caminho, int num_pistas, int num_portoes, int faixa_pistas) {
+    if(!log.abrir(caminho)) {
+        return false;
+    }
+    cabecalho = CabecalhoGravacao();
+    std::memcpy(cabecalho.assinatura, ASSINATURA_GRAVACAO, sizeof(ASSINATURA_GRAVACAO));
+    cabecalho.versao = VERSAO_GRAVACAO;
+    cabecalho.num_pistas = static_cast<uint32_t>(num_pistas);
+    cabecalho.num_portoes = static_cast<uint32_t>(num_portoes);
+    cabecalho.faixa_pistas = static_cast<uint32_t>(faixa_pistas);
+    cabecalho.intervalo_chave_ms = INTERVALO_CHAVE_MS;
+    log.anexar(&cabecalho, sizeof(cabecalho));
+
+    total_quadros = 0;
+    tempo_anterior_ms = 0;
+    indice.clear();
+    anteriores.clear();
+    pistas_anteriores.assign(num_pistas, 0);
+    return true;
+}
+
+void GravadorSimulacao::gravar(int64_t instante_ms, const QuadroSimulacao& quadro) {
+    if(!ativo()) {
+        return;
+    }
+    if(total_quadros == 0) {
+        origem_ms = instante_ms;
+    }
+    int64_t tempo_ms = std::max(tempo_anterior_ms, instante_ms - origem_ms);
+
+    // O registro do mapa de slots não tem ordem; a gravação compara por id
+    atuais.clear();
+    for(const Plane& aviao : quadro.avioes) {
+        atuais.push_back(gravarAviao(aviao));
+    }
+    std::sort(atuais.begin(), atuais.end(), porId);
+
+    uint8_t tipo;
+    size_t segundo = static_cast<size_t>(tempo_ms / INTERVALO_CHAVE_MS);
+    if(total_quadros == 0 || segundo >= indice.size()) {
+        // Primeiro quadro do segundo: quadro-chave, apontado pelo índice (também
+        // pelos segundos sem nenhum quadro, que começam nele)
+        indice.resize(segundo + 1, log.tamanho());
+        tipo = REGISTRO_CHAVE;
+        escreverChave(tempo_ms, quadro);
+    } else {
+        tipo = REGISTRO_DELTA;
+        escreverDelta(tempo_ms - tempo_anterior_ms, quadro);
+    }
+
+    // Tipo e tamanho do corpo na frente, para o leitor pular o registro sem decodificá-lo
+    uint8_t cabecalho_registro[11];
+    size_t n = 0;
+    cabecalho_registro[n++] = tipo;
+    uint64_t tamanho = registro.size();
+    for(; tamanho >= 0x80; tamanho >>= 7) {
+        cabecalho_registro[n++] = static_cast<uint8_t>(tamanho | 0x80);
+    }
+    cabecalho_registro[n++] = static_cast<uint8_t>(tamanho);
+    log.anexar(cabecalho_registro, n);
+    log.anexar(registro.data(), registro.size());
+
+    anteriores.swap(atuais);
+    pistas_anteriores.assign(quadro.pistas_ocupadas.begin(), quadro.pistas_ocupadas.end());
+    pistas_anteriores.resize(cabecalho.num_pistas, 0);
+    tempo_anterior_ms = tempo_ms;
+    total_quadros++;
+}
+
+void GravadorSimulacao::escreverChave(int64_t tempo_ms, const QuadroSimulacao& quadro) {
+    registro.clear();
+    escreverVarint(registro, static_cast<uint64_t>(tempo_ms));
+    escreverVarint(registro, quadro.conflitos.violacoes);
+    escreverVarint(registro, quadro.conflitos.quase_colisoes);
+
+    // Pistas ocupadas, como distâncias entre índices crescentes
+    uint64_t ocupadas = 0;
+    for(size_t i = 0; i < quadro.pistas_ocupadas.size() && i < cabecalho.num_pistas; ++i) {
+        ocupadas += quadro.pistas_ocupadas[i] ? 1 : 0;
+    }
+    escreverVarint(registro, ocupadas);
+    size_t proxima = 0;
+    for(size_t i = 0; i < quadro.pistas_ocupadas.size() && i < cabecalho.num_pistas; ++i) {
+        if(quadro.pistas_ocupadas[i]) {
+            escreverVarint(registro, i - proxima);
+            proxima = i + 1;
+        }
+    }
+
+    escreverVarint(registro, atuais.size());
+    uint32_t id_anterior = 0;
+    for(const AviaoGravado& aviao : atuais) {
+        escreverAviao(registro, aviao, id_anterior);
+        id_anterior = aviao.id;
+    }
+}
+
+void GravadorSimulacao::escreverDelta(int64_t dt_ms, const QuadroSimulacao& quadro) {
+    registro.clear();
+    escreverVarint(registro, static_cast<uint64_t>(dt_ms));
+    escreverVarint(registro, quadro.conflitos.violacoes);
+    escreverVarint(registro, quadro.conflitos.quase_colisoes);
+
+    // Pistas que trocaram de estado
+    uint64_t trocadas = 0;
+    for(size_t i = 0; i < cabecalho.num_pistas; ++i) {
+        char ocupada = i < quadro.pistas_ocupadas.size() && quadro.pistas_ocupadas[i];
+        trocadas += ocupada != pistas_anteriores[i] ? 1 : 0;
+    }
+    escreverVarint(registro, trocadas);
+    size_t proxima = 0;
+    for(size_t i = 0; i < cabecalho.num_pistas; ++i) {
+        char ocupada = i < quadro.pistas_ocupadas.size() && quadro.pistas_ocupadas[i];
+        if(ocupada != pistas_anteriores[i]) {
+            escreverVarint(registro, i - proxima);
+            proxima = i + 1;
+        }
+    }
+
+    // Percorre os dois estados ordenados por id de uma vez
+    removidos.clear();
+    novos.clear();
+    alterados.clear();
+    uint64_t num_removidos = 0, num_novos = 0, num_alterados = 0;
+    uint32_t id_removido = 0, id_novo = 0, id_alterado = 0;
+    size_t a = 0, b = 0;
+    while(a < anteriores.size() || b < atuais.size()) {
+        if(b == atuais.size() || (a < anteriores.size() && anteriores[a].id < atuais[b].id)) {
+            escreverVarint(removidos, anteriores[a].id - id_removido);
+            id_removido = anteriores[a].id;
+            num_removidos++;
+            a++;
+        } else if(a == anteriores.size() || atuais[b].id < anteriores[a].id) {
+            escreverAviao(novos, atuais[b], id_novo);
+            id_novo = atuais[b].id;
+            num_novos++;
+            b++;
+        } else {
+            const AviaoGravado& antes = anteriores[a];
+            const AviaoGravado& agora = atuais[b];
+            int32_t previsto = xPrevisto(antes, dt_ms);
+            uint8_t campos = (agora.x != previsto ? ALTEROU_X : 0) | (agora.y != antes.y ? ALTEROU_Y : 0) |
+                             (agora.fase != antes.fase || agora.pista != antes.pista ? ALTEROU_FASE : 0);
+            if(campos) {
+                escreverVarint(alterados, agora.id - id_alterado);
+                alterados.push_back(campos);
+                if(campos & ALTEROU_X) {
+                    escreverZigZag(alterados, static_cast<int64_t>(agora.x) - previsto);
+                }
+                if(campos & ALTEROU_Y) {
+                    escreverZigZag(alterados, static_cast<int64_t>(agora.y) - antes.y);
+                }
+                if(campos & ALTEROU_FASE) {
+                    alterados.push_back(agora.fase);
+                    escreverVarint(alterados, agora.pista);
+                }
+                id_alterado = agora.id;
+                num_alterados++;
+            }
+            a++;
+            b++;
+        }
+    }
+    escreverVarint(registro, num_removidos);
+    registro.insert(registro.end(), removidos.begin(), removidos.end());
+    escreverVarint(registro, num_novos);
+    registro.insert(registro.end(), novos.begin(), novos.end());
+    escreverVarint(registro, num_alterados);
+    registro.insert(registro.end(), alterados.begin(), alterados.end());
+}
+
+bool GravadorSimulacao::encerrar() {
+    if(!ativo()) {
+        return false;
+    }
+    cabecalho.fim_dados = log.tamanho();
+    cabecalho.duracao_ms = tempo_anterior_ms;
+    cabecalho.quadros = total_quadros;
+
+    // Índice alinhado a 8 bytes depois do último registro
+    static const char zeros[8] = {};
+    log.anexar(zeros, (8 - log.tamanho() % 8) % 8);
+    cabecalho.posicao_indice = log.tamanho();
+    cabecalho.entradas_indice = indice.size();
+    log.anexar(indice.data(), indice.size() * sizeof(uint64_t));
+
+    bool ok = log.sobrescrever(0, &cabecalho, sizeof(cabecalho));
+    return log.fechar() && ok;
+}
+
+ReprodutorSimulacao::ReprodutorSimulacao()
+    : descritor(-1), dados(nullptr), tamanho_arquivo(0), cabecalho(), completa(false), cursor(0),
+      tempo_atual_ms(-1), quadro_valido(false) {}
+
+ReprodutorSimulacao::~ReprodutorSimulacao() {
+#ifndef _WIN32
+    if(dados) {
+        ::munmap(const_cast<uint8_t*>(dados), tamanho_arquivo);
+    }
+    if(descritor >= 0) {
+        ::close(descritor);
+    }
+#endif
+}
+
+bool ReprodutorSimulacao::abrir(const std::string& caminho, std::string& erro) {
+#ifdef _WIN32
+    (void)caminho;
+    erro = "reprodução indisponível no Windows (requer mmap)";
+    return false;
+#else
+    descritor = ::open(caminho.c_str(), O_RDONLY);
+    if(descritor < 0) {
+        erro = "não foi possível abrir o arquivo";
+        return false;
+    }
+    struct stat info;
+    if(::fstat(descritor, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(CabecalhoGravacao)) {
+        erro = "arquivo vazio ou ilegível";
+        return false;
+    }
+    tamanho_arquivo = static_cast<size_t>(info.st_size);
+
+    // Só o espaço de endereços: as páginas são lidas do disco quando a reprodução passa por elas
+    void* mapa = ::mmap(nullptr, tamanho_arquivo, PROT_READ, MAP_SHARED, descritor, 0);
+    if(mapa == MAP_FAILED) {
+        erro = "falha ao mapear o arquivo";
+        return false;
+    }
+    dados = static_cast<const uint8_t*>(mapa);
+
+    std::memcpy(&cabecalho, dados, sizeof(cabecalho));
+    if(std::memcmp(cabecalho.assinatura, ASSINATURA_GRAVACAO, sizeof(ASSINATURA_GRAVACAO)) != 0 ||
+       cabecalho.versao != VERSAO_GRAVACAO || cabecalho.intervalo_chave_ms != INTERVALO_CHAVE_MS) {
+        erro = "não é uma gravação da simulação (ou é de outra versão)";
+        return false;
+    }
+
+    completa = cabecalho.posicao_indice != 0;
+    if(completa) {
+        uint64_t fim_indice = cabecalho.posicao_indice + cabecalho.entradas_indice * sizeof(uint64_t);
+        if(cabecalho.fim_dados > cabecalho.posicao_indice || fim_indice > tamanho_arquivo) {
+            erro = "índice fora do arquivo";
+            return false;
+        }
+        indice.resize(cabecalho.entradas_indice);
+        std::memcpy(indice.data(), dados + cabecalho.posicao_indice, indice.size() * sizeof(uint64_t));
+    } else if(!reconstruirIndice()) {
+        erro = "gravação interrompida sem nenhum quadro";
+        return false;
+    }
+    pistas.assign(cabecalho.num_pistas, 0);
+    return true;
+#endif
+}
+
+// Gravação interrompida antes de encerrar: percorre os registros até o espaço
+// não escrito e refaz o índice, a duração e a contagem de quadros
+bool ReprodutorSimulacao::reconstruirIndice() {
+    cabecalho.fim_dados = tamanho_arquivo;
+    cursor = sizeof(CabecalhoGravacao);
+    uint64_t fim = cursor;
+    uint64_t quadros_lidos = 0;
+    int64_t tempo_ms = 0;
+    while(true) {
+        int64_t tempo_registro;
+        if(!lerTempoProximo(tempo_registro)) {
+            break;
+        }
+        Leitor leitor{dados + cursor + 1, dados + tamanho_arquivo};
+        uint64_t tamanho = leitor.varint();
+        uint64_t proximo = static_cast<uint64_t>(leitor.atual - dados) + tamanho;
+        if(dados[cursor] == REGISTRO_CHAVE) {
+            indice.resize(static_cast<size_t>(tempo_registro / INTERVALO_CHAVE_MS) + 1, cursor);
+        }
+        tempo_ms = tempo_atual_ms = tempo_registro;
+        cursor = fim = proximo;
+        quadros_lidos++;
+    }
+    cabecalho.fim_dados = fim;
+    cabecalho.duracao_ms = tempo_ms;
+    cabecalho.quadros = quadros_lidos;
+    cabecalho.entradas_indice = indice.size();
+    cursor = 0;
+    tempo_atual_ms = -1;
+    return quadros_lidos > 0;
+}
+
+// Tempo do registro no cursor, sem aplicá-lo; falso no fim ou em um registro inválido
+bool ReprodutorSimulacao::lerTempoProximo(int64_t& tempo_ms) const {
+    if(cursor < sizeof(CabecalhoGravacao) || cursor >= cabecalho.fim_dados) {
+        return false;
+    }
+    uint8_t tipo = dados[cursor];
+    if(tipo != REGISTRO_CHAVE && (tipo != REGISTRO_DELTA || tempo_atual_ms < 0)) {
+        return false;
+    }
+    Leitor leitor{dados + cursor + 1, dados + cabecalho.fim_dados};
+    uint64_t tamanho = leitor.varint();
+    if(!leitor.ok || tamanho > static_cast<uint64_t>(leitor.fim - leitor.atual)) {
+        return false;
+    }
+    leitor.fim = leitor.atual + tamanho;
+    uint64_t tempo = leitor.varint();
+    if(!leitor.ok) {
+        return false;
+    }
+    tempo_ms = tipo == REGISTRO_CHAVE ? static_cast<int64_t>(tempo) : tempo_atual_ms + static_cast<int64_t>(tempo);
+    return true;
+}
+
+// Aplica o registro no cursor ao estado decodificado e avança o cursor
+bool ReprodutorSimulacao::aplicarProximo() {
+    int64_t tempo_ms;
+    if(!lerTempoProximo(tempo_ms)) {
+        return false;
+    }
+    uint8_t tipo = dados[cursor];
+    Leitor leitor{dados + cursor + 1, dados + cabecalho.fim_dados};
+    uint64_t tamanho = leitor.varint();
+    leitor.fim = leitor.atual + tamanho;
+    leitor.varint();    // Tempo, já lido acima
+
+    ContagemConflitos lidos;
+    lidos.violacoes = leitor.varint();
+    lidos.quase_colisoes = leitor.varint();
+
+    if(tipo == REGISTRO_CHAVE) {
+        std::fill(pistas.begin(), pistas.end(), 0);
+    }
+    uint64_t num_pistas = leitor.varint();
+    size_t pista = 0;
+    for(uint64_t i = 0; i < num_pistas && leitor.ok; ++i) {
+        pista += leitor.varint();
+        if(pista >= pistas.size()) {
+            return false;
+        }
+        pistas[pista] = tipo == REGISTRO_CHAVE ? 1 : !pistas[pista];
+        pista++;
+    }
+
+    if(tipo == REGISTRO_CHAVE) {
+        uint64_t num_avioes = leitor.varint();
+        proximos.clear();
+        uint32_t id = 0;
+        for(uint64_t i = 0; i < num_avioes && leitor.ok; ++i) {
+            proximos.push_back(lerAviao(leitor, id));
+            id = proximos.back().id;
+        }
+    } else {
+        ids_removidos.clear();
+        novos.clear();
+        alterados.clear();
+        uint32_t id = 0;
+        uint64_t n = leitor.varint();
+        for(uint64_t i = 0; i < n && leitor.ok; ++i) {
+            id += static_cast<uint32_t>(leitor.varint());
+            ids_removidos.push_back(id);
+        }
+        id = 0;
+        n = leitor.varint();
+        for(uint64_t i = 0; i < n && leitor.ok; ++i) {
+            novos.push_back(lerAviao(leitor, id));
+            id = novos.back().id;
+        }
+        id = 0;
+        n = leitor.varint();
+        for(uint64_t i = 0; i < n && leitor.ok; ++i) {
+            AviaoGravado alteracao = AviaoGravado();
+            id += static_cast<uint32_t>(leitor.varint());
+            alteracao.id = id;
+            uint8_t campos = leitor.byte();
+            if(campos & ALTEROU_X) alteracao.x = static_cast<int32_t>(leitor.zigzag());
+            if(campos & ALTEROU_Y) alteracao.y = static_cast<int32_t>(leitor.zigzag());
+            if(campos & ALTEROU_FASE) {
+                alteracao.fase = leitor.byte();
+                alteracao.pista = static_cast<uint16_t>(leitor.varint());
+            }
+            alterados.emplace_back(alteracao, campos);
+        }
+
+        int64_t dt_ms = tempo_ms - tempo_atual_ms;
+
+        // Estado anterior menos os removidos, com as alterações e a posição
+        // prevista dos demais, intercalado com os novos (tudo ordenado por id)
+        proximos.clear();
+        size_t r = 0, alt = 0, nv = 0;
+        for(const AviaoGravado& antes : avioes) {
+            while(nv < novos.size() && novos[nv].id < antes.id) {
+                proximos.push_back(novos[nv++]);
+            }
+            if(r < ids_removidos.size() && ids_removidos[r] == antes.id) {
+                r++;
+                continue;
+            }
+            AviaoGravado depois = antes;
+            depois.x = xPrevisto(antes, dt_ms);
+            if(alt < alterados.size() && alterados[alt].first.id == antes.id) {
+                const AviaoGravado& alteracao = alterados[alt].first;
+                uint8_t campos = alterados[alt].second;
+                if(campos & ALTEROU_X) depois.x += alteracao.x;
+                if(campos & ALTEROU_Y) depois.y += alteracao.y;
+                if(campos & ALTEROU_FASE) {
+                    depois.fase = alteracao.fase;
+                    depois.pista = alteracao.pista;
+                }
+                alt++;
+            }
+            proximos.push_back(depois);
+        }
+        while(nv < novos.size()) {
+            proximos.push_back(novos[nv++]);
+        }
+    }
+    if(!leitor.ok) {
+        return false;
+    }
+
+    avioes.swap(proximos);
+    conflitos = lidos;
+    tempo_atual_ms = tempo_ms;
+    cursor = static_cast<uint64_t>(leitor.fim - dados);
+    quadro_valido = false;
+    return true;
+}
+
+// Posiciona no quadro-chave do segundo de tempo_ms pelo índice; se o segundo
+// começou sem quadro, o quadro-chave apontado é posterior e vale o do segundo anterior
+void ReprodutorSimulacao::buscar(int64_t tempo_ms) {
+    if(indice.empty()) {
+        return;
+    }
+    size_t segundo = std::min(static_cast<size_t>(tempo_ms / INTERVALO_CHAVE_MS), indice.size() - 1);
+    tempo_atual_ms = -1;
+    while(true) {
+        cursor = indice[segundo];
+        int64_t tempo_chave;
+        if(segundo == 0 || !lerTempoProximo(tempo_chave) || tempo_chave <= tempo_ms) {
+            break;
+        }
+        segundo--;
+    }
+    aplicarProximo();
+}
+
+const QuadroSimulacao& ReprodutorSimulacao::quadroEm(int64_t tempo_ms) {
+    tempo_ms = std::max<int64_t>(0, std::min(tempo_ms, cabecalho.duracao_ms));
+    if(tempo_atual_ms < 0 || tempo_ms < tempo_atual_ms ||
+       tempo_ms / INTERVALO_CHAVE_MS > tempo_atual_ms / INTERVALO_CHAVE_MS + 1) {
+        buscar(tempo_ms);
+    }
+    int64_t proximo_ms;
+    while(lerTempoProximo(proximo_ms) && proximo_ms <= tempo_ms) {
+        if(!aplicarProximo()) {
+            break;
+        }
+    }
+    if(!quadro_valido) {
+        montarQuadro();
+    }
+    return quadro;
+}
+
+void ReprodutorSimulacao::montarQuadro() {
+    quadro.avioes.clear();
+    for(const AviaoGravado& aviao : avioes) {
+        quadro.avioes.push_back(reproduzirAviao(aviao));
+    }
+    quadro.pistas_ocupadas = pistas;
+    quadro.conflitos = conflitos;
+    quadro.numero++;
+    quadro_valido = true;
+}
@@ -0,0 +1,188 @@
+#ifndef GRAVACAO_H
+#define GRAVACAO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "quadro.h"
+
+// Gravação e reprodução de execuções da versão gráfica.
+//
+// O tick grava cada quadro publicado (aviões e pistas) em um log só de anexação
+// escrito por uma janela mmap. A cada segundo virtual vai um quadro-chave com o
+// estado completo; entre eles, só as diferenças para o quadro anterior, em
+// inteiros de tamanho variável: aviões que entraram, saíram ou mudaram e pistas
+// que trocaram de estado. Um avião em voo que só seguiu em frente na velocidade
+// de sempre não gera nenhum byte, porque o leitor prevê a posição a partir do
+// tempo decorrido.
+//
+// O índice do fim do arquivo aponta, para cada segundo, o quadro-chave que o
+// começa; a reprodução mapeia o arquivo inteiro e chega a qualquer instante
+// lendo um quadro-chave e no máximo um segundo de diferenças, sem carregar o
+// resto da gravação na memória.
+
+constexpr char ASSINATURA_GRAVACAO[8] = {'G', 'R', 'A', 'V', 'A', 'C', '0', '1'};
+
+// Intervalo entre quadros-chave e granularidade do índice (milissegundos virtuais)
+constexpr int64_t INTERVALO_CHAVE_MS = 1000;
+
+// Posições gravadas em quartos de pixel
+constexpr int ESCALA_POSICAO = 4;
+
+// Cabeçalho do arquivo; posicao_indice 0 indica gravação não encerrada, cujo
+// índice é reconstruído percorrendo os registros
+struct CabecalhoGravacao {
+    char assinatura[8];
+    uint32_t versao;
+    uint32_t num_pistas;
+    uint32_t num_portoes;       // 0: desembarque na própria pista
+    uint32_t faixa_pistas;      // Altura (px) da faixa do solo ocupada pelas pistas
+    int64_t intervalo_chave_ms;
+    int64_t duracao_ms;         // Instante do último quadro, a partir do primeiro
+    uint64_t fim_dados;         // Posição depois do último registro
+    uint64_t posicao_indice;    // Índice: uint64_t por segundo, posição do quadro-chave
+    uint64_t entradas_indice;
+    uint64_t quadros;
+};
+static_assert(sizeof(CabecalhoGravacao) == 72, "CabecalhoGravacao deve ter 72 bytes");
+
+// Avião como gravado: o suficiente para desenhá-lo
+struct AviaoGravado {
+    uint32_t id;
+    int32_t x, y;       // Em 1/ESCALA_POSICAO de pixel
+    uint8_t fase;       // FaseGravada
+    uint16_t pista;
+};
+
+enum FaseGravada : uint8_t {
+    FASE_VOANDO_DIREITA,
+    FASE_VOANDO_ESQUERDA,
+    FASE_EM_SOLO,
+    FASE_DECOLANDO
+};
+
+// Arquivo escrito só no fim através de uma janela mmap que desliza conforme
+// ele cresce: a escrita é uma cópia para a memória e o kernel grava as páginas
+// quando quiser. Ao fechar, o arquivo é cortado no tamanho escrito.
+class LogMapeado {
+public:
+    static constexpr size_t TAMANHO_JANELA = 8u << 20;
+
+    LogMapeado();
+    ~LogMapeado();
+
+    LogMapeado(const LogMapeado&) = delete;
+    LogMapeado& operator=(const LogMapeado&) = delete;
+
+    bool abrir(const std::string& caminho);
+    bool aberto() const { return descritor >= 0; }
+
+    void anexar(const void* dados, size_t tamanho);
+    uint64_t tamanho() const { return escritos; }
+
+    // Reescreve bytes já anexados (o cabeçalho, ao encerrar)
+    bool sobrescrever(uint64_t posicao, const void* dados, size_t tamanho);
+
+    bool fechar();
+
+private:
+    bool mapearJanela(uint64_t inicio);
+
+    int descritor;
+    char* janela;
+    uint64_t inicio_janela;
+    uint64_t escritos;
+    bool falhou;
+};
+
+// Grava os quadros do tick. Um só escritor (o tick); encerrar depois que ele parou.
+class GravadorSimulacao {
+public:
+    GravadorSimulacao();
+
+    GravadorSimulacao(const GravadorSimulacao&) = delete;
+    GravadorSimulacao& operator=(const GravadorSimulacao&) = delete;
+
+    // Cria o arquivo; até lá gravar não faz nada. Portões e faixa das pistas
+    // vão no cabeçalho para a reprodução montar o mesmo solo.
+    bool abrir(const std::string& caminho, int num_pistas, int num_portoes, int faixa_pistas);
+    bool ativo() const { return log.aberto(); }
+
+    // Grava o quadro no instante virtual do último passo aplicado pelo tick
+    void gravar(int64_t instante_ms, const QuadroSimulacao& quadro);
+
+    // Anexa o índice, completa o cabeçalho e fecha o arquivo
+    bool encerrar();
+
+    uint64_t quadros() const { return total_quadros; }
+    uint64_t bytes() const { return log.tamanho(); }
+
+private:
+    void escreverChave(int64_t tempo_ms, const QuadroSimulacao& quadro);
+    void escreverDelta(int64_t dt_ms, const QuadroSimulacao& quadro);
+
+    LogMapeado log;
+    CabecalhoGravacao cabecalho;
+    int64_t origem_ms;                      // Instante do primeiro quadro
+    int64_t tempo_anterior_ms;              // Relativo à origem
+    uint64_t total_quadros;
+    std::vector<uint64_t> indice;           // Posição do quadro-chave de cada segundo
+    std::vector<AviaoGravado> anteriores;   // Estado do quadro anterior, por id
+    std::vector<AviaoGravado> atuais;
+    std::vector<char> pistas_anteriores;
+    std::vector<uint8_t> registro;          // Corpo do registro em montagem
+    std::vector<uint8_t> removidos, novos, alterados;   // Seções do delta, contadas antes de anexar
+};
+
+// Lê uma gravação mapeada na memória e devolve o estado em qualquer instante
+class ReprodutorSimulacao {
+public:
+    ReprodutorSimulacao();
+    ~ReprodutorSimulacao();
+
+    ReprodutorSimulacao(const ReprodutorSimulacao&) = delete;
+    ReprodutorSimulacao& operator=(const ReprodutorSimulacao&) = delete;
+
+    bool abrir(const std::string& caminho, std::string& erro);
+
+    int numPistas() const { return static_cast<int>(cabecalho.num_pistas); }
+    int numPortoes() const { return static_cast<int>(cabecalho.num_portoes); }
+    int faixaPistas() const { return static_cast<int>(cabecalho.faixa_pistas); }
+    int64_t duracaoMs() const { return cabecalho.duracao_ms; }
+    uint64_t quadros() const { return cabecalho.quadros; }
+    bool encerradaCorretamente() const { return completa; }
+
+    // Estado do último quadro gravado até tempo_ms (a partir do primeiro quadro).
+    // Avançar pouco aplica só as diferenças seguintes; voltar ou saltar mais de
+    // um segundo recomeça do quadro-chave indicado pelo índice.
+    const QuadroSimulacao& quadroEm(int64_t tempo_ms);
+
+private:
+    void buscar(int64_t tempo_ms);
+    bool lerTempoProximo(int64_t& tempo_ms) const;
+    bool aplicarProximo();
+    bool reconstruirIndice();
+    void montarQuadro();
+
+    int descritor;
+    const uint8_t* dados;
+    size_t tamanho_arquivo;
+    CabecalhoGravacao cabecalho;
+    bool completa;
+    std::vector<uint64_t> indice;
+    uint64_t cursor;                    // Próximo registro a aplicar
+    int64_t tempo_atual_ms;             // Tempo do último registro aplicado (-1: nenhum)
+    std::vector<AviaoGravado> avioes;   // Estado decodificado, por id
+    std::vector<AviaoGravado> proximos;
+    std::vector<uint32_t> ids_removidos;
+    std::vector<AviaoGravado> novos;
+    std::vector<std::pair<AviaoGravado, uint8_t>> alterados;   // Valores lidos e campos presentes
+    std::vector<char> pistas;
+    ContagemConflitos conflitos;
+    QuadroSimulacao quadro;
+    bool quadro_valido;
+};
+
+#endif
@@ -2,20 +2,32 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <pthread.h>
-#include <unistd.h>
 #include <cstdlib>
 #include <ctime>
 #include <mutex>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <thread>
 
 #include <SDL.h>        
 #include <SDL_ttf.h>    
 
 #include "aviao.h"
-#include "semaforo.h"
+#include "alocador.h"
 #include "utils.h"
 #include "pista.h" 
+#include "configuracao.h"
+#include "simulacao.h"
+#include "pool_tarefas.h"
+#include "quadro.h"
+#include "execucao.h"
+#include "varredura.h"
+#include "ritmo_quadros.h"
+#include "gravacao.h"
+#include "rede.h"
 
 using namespace std;
 
@@ -23,15 +35,8 @@ using namespace std;
 constexpr int LARGURA_JANELA = 800;
 constexpr int ALTURA_JANELA = 600;
 
-// Estrutura de configurações
-struct Configuracao {
-    int tempo_pouso = 1;
-    int tempo_desembarque = 5;
-    int tempo_decolagem = 1;
-    int tempo_entre_avioes = 10;
-    int num_pistas = 2;
-    int num_avioes = 5;
-};
+// Espera máxima por eventos na tela de configuração, que não muda sozinha
+constexpr int ESPERA_OCIOSA_MS = 1000;
 
 // Enum para representar o estado atual da aplicação
 enum class EstadoApp {
@@ -39,13 +44,26 @@ enum class EstadoApp {
     SIMULACAO
 };
 
-// Estrutura para gerenciar recursos compartilhados
-struct RecursosCompartilhados {
-    vector<Plane> avioes;
-    vector<Runway> pistas; // Lista de pistas
-    mutex mutex_avioes;
-    Semaforo* semaforo_pistas;
-};
+// Milissegundos como segundos, sem casas decimais desnecessárias ("5", "0.25")
+string formatarSegundos(int64_t ms) {
+    string texto = to_string(ms / 1000);
+    if(ms % 1000 != 0) {
+        string fracao = to_string(1000 + ms % 1000).substr(1);
+        texto += "." + fracao.substr(0, fracao.find_last_not_of('0') + 1);
+    }
+    return texto;
+}
+
+// Lê segundos com até três casas decimais ("1", "0.25") em milissegundos
+bool lerSegundos(const char* texto, int64_t& ms) {
+    char* fim = nullptr;
+    double segundos = strtod(texto, &fim);
+    if(fim == texto || *fim != '\0') {
+        return false;
+    }
+    ms = static_cast<int64_t>(llround(segundos * 1000.0));
+    return true;
+}
 
 // Função para renderizar interface de configuração
 void renderizarConfiguracao(SDL_Renderer* renderer, TTF_Font* font, const Configuracao& config, 
@@ -60,16 +78,16 @@ void renderizarConfiguracao(SDL_Renderer* renderer, TTF_Font* font, const Config
     renderizarTexto(renderer, font, "Configurações de Simulação", 250, 50, preto);
 
     // Rótulos para cada configuração
-    renderizarTexto(renderer, font, "Tempo de Pouso (s): " + to_string(config.tempo_pouso), 100, 150, preto);
-    renderizarTexto(renderer, font, "Tempo de Desembarque (s): " + to_string(config.tempo_desembarque), 100, 200, preto);
-    renderizarTexto(renderer, font, "Tempo de Decolagem (s): " + to_string(config.tempo_decolagem), 100, 250, preto);
-    renderizarTexto(renderer, font, "Tempo entre Aviões (s): " + to_string(config.tempo_entre_avioes) + "                        (Recomendado: >=" + to_string(config.tempo_decolagem + config.tempo_pouso + config.tempo_desembarque) + "s)", 100, 300, preto);
+    renderizarTexto(renderer, font, "Tempo de Pouso (s): " + formatarSegundos(config.tempo_pouso_ms), 100, 150, preto);
+    renderizarTexto(renderer, font, "Tempo de Desembarque (s): " + formatarSegundos(config.tempo_desembarque_ms), 100, 200, preto);
+    renderizarTexto(renderer, font, "Tempo de Decolagem (s): " + formatarSegundos(config.tempo_decolagem_ms), 100, 250, preto);
+    renderizarTexto(renderer, font, "Tempo entre Aviões (s): " + formatarSegundos(config.tempo_entre_avioes_ms) + "                        (Recomendado: >=" + formatarSegundos(config.tempo_decolagem_ms + config.tempo_pouso_ms + config.tempo_desembarque_ms) + "s)", 100, 300, preto);
     renderizarTexto(renderer, font, "Número de Pistas: " + to_string(config.num_pistas), 100, 350, preto);
     renderizarTexto(renderer, font, "Número de Aviões: " + to_string(config.num_avioes), 100, 400, preto);
 
     // Renderizar botões "+"
     for(size_t i = 0; i < botoes_mais.size(); ++i) {
-        if(i == 4 && config.num_pistas >= 3) { // Botão "+" para pistas quando o máximo for atingido
+        if(i == 4 && config.num_pistas >= MAX_PISTAS) { // Botão "+" para pistas quando o máximo for atingido
             // Renderiza botão "+" desabilitado (cinza escuro)
             SDL_SetRenderDrawColor(renderer, 169, 169, 169, 255); // Cinza Escuro
             SDL_RenderFillRect(renderer, &botoes_mais[i]);
@@ -90,7 +108,7 @@ void renderizarConfiguracao(SDL_Renderer* renderer, TTF_Font* font, const Config
         SDL_SetRenderDrawColor(renderer, vermelho.r, vermelho.g, vermelho.b, vermelho.a);
         
         // Se for o botão "-" para tempo_entre_avioes e já estiver no mínimo, renderize em cinza
-        if(i == 3 && config.tempo_entre_avioes <= 4) {
+        if(i == 3 && config.tempo_entre_avioes_ms <= 4000) {
             SDL_SetRenderDrawColor(renderer, 169, 169, 169, 255);  // Cinza para desabilitado
         }
         
@@ -109,10 +127,60 @@ void renderizarConfiguracao(SDL_Renderer* renderer, TTF_Font* font, const Config
 // Define um tamanho constante para todos os aviões
 constexpr float TAMANHO_AVIAO = 15.0f;
 
-// Função para renderizar interface de simulação
-void renderizarSimulacao(SDL_Renderer* renderer, TTF_Font* font, const Configuracao& config, 
-                         RecursosCompartilhados& recursos, const SDL_Color& branco, 
-                         const SDL_Color& azul_celar, const SDL_Color& cinza_escuro, const SDL_Color& cinza) {
+// Distribui as pistas sobre o solo. Até 3 mantêm o desenho original (200 px com
+// 50 px entre elas); acima disso formam uma grade de até 64 colunas, com a
+// largura e a altura encolhendo para caber na faixa do solo (menor com portões)
+void montarPistas(int num_pistas, std::vector<Runway>& pistas, int altura_faixa = 90) {
+    int Y_solo = ALTURA_JANELA - 100; // Posicionar pistas sobre o solo
+    if(num_pistas <= 3) {
+        int largura_pista = 200;
+        int altura_pista = 20;
+        int espaco = 50;
+        int largura_total = num_pistas * largura_pista + (num_pistas - 1) * espaco;
+        int inicioX = (LARGURA_JANELA - largura_total) / 2;
+        for(int i = 0; i < num_pistas; ++i) {
+            SDL_Rect retangulo_pista = { inicioX + i * (largura_pista + espaco), Y_solo, largura_pista, altura_pista };
+            pistas.emplace_back(i + 1, retangulo_pista);
+        }
+        return;
+    }
+
+    int colunas = std::min(num_pistas, 64);
+    int linhas = (num_pistas + colunas - 1) / colunas;
+    int largura_celula = LARGURA_JANELA / colunas;
+    int espaco = std::max(1, largura_celula / 5);
+    int altura_celula = altura_faixa / linhas;
+    int altura_pista = std::max(2, std::min(20, altura_celula - 2));
+    int inicioX = (LARGURA_JANELA - colunas * largura_celula + espaco) / 2;
+    for(int i = 0; i < num_pistas; ++i) {
+        SDL_Rect retangulo_pista = { inicioX + (i % colunas) * largura_celula, Y_solo + (i / colunas) * altura_celula,
+                                     largura_celula - espaco, altura_pista };
+        pistas.emplace_back(i + 1, retangulo_pista);
+    }
+}
+
+// Portões em uma fileira na borda de baixo do solo, abaixo das pistas
+constexpr int ALTURA_PORTAO = 8;
+constexpr int FAIXA_PISTAS_COM_PORTOES = 45;
+
+void montarPortoes(int num_portoes, std::vector<Runway>& portoes) {
+    if(num_portoes <= 0) {
+        return;
+    }
+    int largura_celula = std::min(40, LARGURA_JANELA / num_portoes);
+    int espaco = std::max(0, largura_celula / 4);
+    int inicioX = (LARGURA_JANELA - num_portoes * largura_celula + espaco) / 2;
+    for(int i = 0; i < num_portoes; ++i) {
+        SDL_Rect retangulo_portao = { inicioX + i * largura_celula, ALTURA_JANELA - 5 - ALTURA_PORTAO,
+                                      std::max(1, largura_celula - espaco), ALTURA_PORTAO };
+        portoes.emplace_back(i + 1, retangulo_portao);
+    }
+}
+
+// Desenha céu, solo, pistas, portões e aviões de um quadro (da simulação ou de uma gravação)
+void desenharCena(SDL_Renderer* renderer, TTF_Font* font, const vector<Runway>& pistas, const vector<Runway>& portoes,
+                  const QuadroSimulacao& quadro, LoteTriangulos& lote_avioes, const SDL_Color& branco,
+                  const SDL_Color& azul_celar, const SDL_Color& cinza_escuro, const SDL_Color& cinza) {
     // Limpa a tela com fundo azul celar
     SDL_SetRenderDrawColor(renderer, azul_celar.r, azul_celar.g, azul_celar.b, azul_celar.a);
     SDL_RenderClear(renderer);
@@ -122,20 +190,45 @@ void renderizarSimulacao(SDL_Renderer* renderer, TTF_Font* font, const Configura
     SDL_Rect solo = {0, ALTURA_JANELA - 100, LARGURA_JANELA, 100};
     SDL_RenderFillRect(renderer, &solo);
 
-    // Desenha pistas
-    for(auto& pista : recursos.pistas) {
-        SDL_Rect retangulo_pista = pista.rect;
-        if(pista.occupied) {
-            SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Vermelho se ocupada
+    // Desenha pistas em dois lotes (livres e ocupadas), uma chamada por cor
+    static std::vector<SDL_Rect> pistas_livres, pistas_ocupadas;
+    pistas_livres.clear();
+    pistas_ocupadas.clear();
+    for(size_t i = 0; i < pistas.size(); ++i) {
+        if(i < quadro.pistas_ocupadas.size() && quadro.pistas_ocupadas[i]) {
+            pistas_ocupadas.push_back(pistas[i].rect);
         } else {
-            SDL_SetRenderDrawColor(renderer, cinza.r, cinza.g, cinza.b, cinza.a); // Cinza se livre
+            pistas_livres.push_back(pistas[i].rect);
         }
-        SDL_RenderFillRect(renderer, &retangulo_pista);
+    }
+    SDL_SetRenderDrawColor(renderer, cinza.r, cinza.g, cinza.b, cinza.a); // Cinza se livre
+    SDL_RenderFillRects(renderer, pistas_livres.data(), static_cast<int>(pistas_livres.size()));
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); // Vermelho se ocupada
+    SDL_RenderFillRects(renderer, pistas_ocupadas.data(), static_cast<int>(pistas_ocupadas.size()));
+
+    // Portões num lote só; quem está nele é o avião parado em cima
+    static std::vector<SDL_Rect> retangulos_portoes;
+    retangulos_portoes.clear();
+    for(const Runway& portao : portoes) {
+        retangulos_portoes.push_back(portao.rect);
+    }
+    SDL_SetRenderDrawColor(renderer, 200, 170, 60, 255);
+    SDL_RenderFillRects(renderer, retangulos_portoes.data(), static_cast<int>(retangulos_portoes.size()));
 
-        // Renderizar ID da pista no centro
+    // Renderizar ID da pista no centro, se o rótulo mais largo (o da última) cabe na pista;
+    // com dezenas de pistas estreitas os rótulos são omitidos
+    bool rotulos_cabem = false;
+    if(!pistas.empty()) {
+        int largura_label = 0, altura_label = 0;
+        tamanhoTexto(renderer, font, "Pista " + std::to_string(pistas.back().id), branco,
+                     largura_label, altura_label);
+        rotulos_cabem = largura_label <= pistas.back().rect.w;
+    }
+    for(size_t i = 0; rotulos_cabem && i < pistas.size(); ++i) {
+        const Runway& pista = pistas[i];
         std::string label_pista = "Pista " + std::to_string(pista.id);
-        int largura_label, altura_label;
-        TTF_SizeUTF8(font, label_pista.c_str(), &largura_label, &altura_label);
+        int largura_label = 0, altura_label = 0;
+        tamanhoTexto(renderer, font, label_pista, branco, largura_label, altura_label);
         renderizarTexto(renderer, font, label_pista, pista.rect.x + (pista.rect.w - largura_label) / 2, 
                        pista.rect.y + (pista.rect.h - altura_label) / 2, branco);
     }
@@ -143,60 +236,600 @@ void renderizarSimulacao(SDL_Renderer* renderer, TTF_Font* font, const Configura
     // Renderizar título da simulação
     renderizarTexto(renderer, font, "Simulação de Aeroporto", 300, 20, branco);
 
-    // Renderizar aviões
-    {
-        lock_guard<mutex> lock(recursos.mutex_avioes);
-        size_t numAvioes = recursos.avioes.size();
-        //cout << "Rendering simulation: " << numAvioes << " aviões.\n"; // Mensagem de depuração
-        for (const auto& aviao : recursos.avioes) {
-            if(!aviao.aterrissou) {
-                // Avião está no céu
-                if(aviao.movendoParaDireita) {
-                    // Apontando para a direita
-                    preencherTriangulo(renderer,
-                                      static_cast<Sint16>(aviao.x),
-                                      static_cast<Sint16>(aviao.y),
-                                      TAMANHO_AVIAO,
-                                      OrientacaoTriangulo::DIREITA,
-                                      aviao.cor);
-                } else {
-                    // Apontando para a esquerda
-                    preencherTriangulo(renderer,
-                                      static_cast<Sint16>(aviao.x),
-                                      static_cast<Sint16>(aviao.y),
-                                      TAMANHO_AVIAO,
-                                      OrientacaoTriangulo::ESQUERDA,
-                                      aviao.cor);
-                }
+    // Conflitos entre aviões em voo no último tick, logo acima do solo
+    renderizarTextoVariavel(renderer, font, "Conflitos: " + std::to_string(quadro.conflitos.violacoes) + " violações, " +
+                            std::to_string(quadro.conflitos.quase_colisoes) + " quase colisões", 10, ALTURA_JANELA - 125, branco);
+
+    // Renderizar aviões a partir do quadro publicado, todos em um único lote de vértices
+    lote_avioes.limpar();
+    for (const auto& aviao : quadro.avioes) {
+        if(!aviao.aterrissou) {
+            // Avião está no céu: apontando para a direção do movimento
+            lote_avioes.adicionar(static_cast<Sint16>(aviao.x), static_cast<Sint16>(aviao.y), TAMANHO_AVIAO,
+                                  aviao.movendoParaDireita ? OrientacaoTriangulo::DIREITA : OrientacaoTriangulo::ESQUERDA,
+                                  aviao.cor);
+        }
+        else if(aviao.cor.r == 255 && aviao.cor.g == 0 && aviao.cor.b == 0) {
+            // Avião aterrissado: vermelho e apontando para baixo
+            lote_avioes.adicionar(static_cast<Sint16>(aviao.x), static_cast<Sint16>(aviao.y), TAMANHO_AVIAO,
+                                  OrientacaoTriangulo::BAIXO, aviao.cor);
+        }
+        else if(aviao.cor.r == 0 && aviao.cor.g == 255 && aviao.cor.b == 0) {
+            // Avião decolando: verde e apontando para cima
+            lote_avioes.adicionar(static_cast<Sint16>(aviao.x), static_cast<Sint16>(aviao.y), TAMANHO_AVIAO,
+                                  OrientacaoTriangulo::CIMA, aviao.cor);
+        }
+    }
+    lote_avioes.desenhar(renderer);
+}
+
+// Função para renderizar interface de simulação
+void renderizarSimulacao(SDL_Renderer* renderer, TTF_Font* font, const Configuracao& config, 
+                         RecursosCompartilhados& recursos, LoteTriangulos& lote_avioes, const SDL_Color& branco, 
+                         const SDL_Color& azul_celar, const SDL_Color& cinza_escuro, const SDL_Color& cinza) {
+    // Último quadro publicado pela simulação (atualizado pelo laço principal), sem travar os aviões
+    desenharCena(renderer, font, recursos.pistas, recursos.portoes, recursos.quadros.leitura(), lote_avioes, branco,
+                 azul_celar, cinza_escuro, cinza);
+
+    // Velocidade e tempo do relógio da simulação
+    renderizarTextoVariavel(renderer, font, "Velocidade: " + std::to_string(static_cast<int>(recursos.relogio.escala())) +
+                            "x   Tempo: " + std::to_string((recursos.relogio.agoraMs() - recursos.inicio_ms) / 1000) +
+                            " s   R: nova simulação",
+                            10, 50, branco);
+}
+
+// Opções da execução que não fazem parte da configuração da simulação
+struct OpcoesExecucao {
+    bool headless = false;
+    string arquivo_metricas;                // Vazio: não grava métricas
+    string arquivo_rastro = "rastro.bin";   // Rastro binário da versão gráfica (vazio: desligado)
+    string arquivo_varredura;               // Especificação da varredura de parâmetros (vazio: execução única)
+    string arquivo_saida = "varredura.csv"; // Tabela agregada da varredura
+    unsigned threads = 0;                   // Threads da varredura e da rede (0: uma por núcleo)
+    double velocidade = 1.0;                // Escala inicial do relógio da versão gráfica
+    string arquivo_gravacao;                // Gravação dos quadros para reprodução (vazio: desligada)
+    string arquivo_reproducao;              // Reproduz uma gravação em vez de simular
+    ConfiguracaoRede rede;                  // Mais de um aeroporto: rede simulada sem janela
+};
+
+// Função para ler os argumentos de linha de comando (modo headless e parâmetros da configuração)
+bool lerArgumentos(int argc, char* argv[], Configuracao& config, OpcoesExecucao& opcoes) {
+    for(int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if(arg == "--headless") {
+            opcoes.headless = true;
+            continue;
+        }
+
+        if(arg == "--politica" && i + 1 < argc) {
+            if(!politicaPorNome(argv[++i], config.politica_pistas)) {
+                cerr << "Política desconhecida: " << argv[i] << " (use fifo, menor-servico, prioridade ou balanceamento)" << endl;
+                return false;
             }
-            else {
-                // Avião aterrissado ou decolando
-                if(aviao.cor.r == 255 && aviao.cor.g == 0 && aviao.cor.b == 0) {
-                    // Avião aterrissado: vermelho e apontando para baixo
-                    preencherTriangulo(renderer,
-                                      static_cast<Sint16>(aviao.x),
-                                      static_cast<Sint16>(aviao.y),
-                                      TAMANHO_AVIAO,
-                                      OrientacaoTriangulo::BAIXO,
-                                      aviao.cor);
-                }
-                else if(aviao.cor.r == 0 && aviao.cor.g == 255 && aviao.cor.b == 0) {
-                    // Avião decolando: verde e apontando para cima
-                    preencherTriangulo(renderer,
-                                      static_cast<Sint16>(aviao.x),
-                                      static_cast<Sint16>(aviao.y),
-                                      TAMANHO_AVIAO,
-                                      OrientacaoTriangulo::CIMA,
-                                      aviao.cor);
+            continue;
+        }
+
+        if(arg == "--chegadas" && i + 1 < argc) {
+            if(!chegadasPorNome(argv[++i], config.chegadas)) {
+                cerr << "Chegadas desconhecidas: " << argv[i] << " (use regular, poisson, rajadas ou diurna)" << endl;
+                return false;
+            }
+            continue;
+        }
+
+        if(arg == "--programacao" && i + 1 < argc) {
+            config.chegadas = TipoChegadas::ARQUIVO;
+            config.arquivo_chegadas = argv[++i];
+            continue;
+        }
+
+        if(arg == "--semente" && i + 1 < argc) {
+            config.semente = strtoull(argv[++i], nullptr, 10);
+            continue;
+        }
+
+        if(arg == "--metricas" && i + 1 < argc) {
+            opcoes.arquivo_metricas = argv[++i];
+            continue;
+        }
+
+        if(arg == "--rastro" && i + 1 < argc) {
+            opcoes.arquivo_rastro = argv[++i];
+            continue;
+        }
+
+        if(arg == "--varredura" && i + 1 < argc) {
+            opcoes.arquivo_varredura = argv[++i];
+            continue;
+        }
+
+        if(arg == "--saida" && i + 1 < argc) {
+            opcoes.arquivo_saida = argv[++i];
+            continue;
+        }
+
+        if(arg == "--threads" && i + 1 < argc) {
+            opcoes.threads = static_cast<unsigned>(max(0, atoi(argv[++i])));
+            continue;
+        }
+
+        if(arg == "--velocidade" && i + 1 < argc) {
+            opcoes.velocidade = atof(argv[++i]);
+            continue;
+        }
+
+        if(arg == "--voo-rede" && i + 1 < argc) {
+            if(!lerSegundos(argv[++i], opcoes.rede.tempo_voo_ms)) {
+                cerr << "Tempo inválido para --voo-rede: " << argv[i] << endl;
+                return false;
+            }
+            continue;
+        }
+
+        if(arg == "--aeroportos" && i + 1 < argc) {
+            opcoes.rede.aeroportos = atoi(argv[++i]);
+            continue;
+        }
+
+        if(arg == "--escalas" && i + 1 < argc) {
+            opcoes.rede.escalas = atoi(argv[++i]);
+            continue;
+        }
+
+        if(arg == "--gravar" && i + 1 < argc) {
+            opcoes.arquivo_gravacao = argv[++i];
+            continue;
+        }
+
+        if(arg == "--reproduzir" && i + 1 < argc) {
+            opcoes.arquivo_reproducao = argv[++i];
+            continue;
+        }
+
+        // Tempos em segundos, com frações de segundo
+        int64_t* tempo = nullptr;
+        if(arg == "--pouso") tempo = &config.tempo_pouso_ms;
+        else if(arg == "--desembarque") tempo = &config.tempo_desembarque_ms;
+        else if(arg == "--decolagem") tempo = &config.tempo_decolagem_ms;
+        else if(arg == "--intervalo") tempo = &config.tempo_entre_avioes_ms;
+        else if(arg == "--taxi") tempo = &config.tempo_taxi_ms;
+        if(tempo && i + 1 < argc) {
+            if(!lerSegundos(argv[++i], *tempo)) {
+                cerr << "Tempo inválido para " << arg << ": " << argv[i] << endl;
+                return false;
+            }
+            continue;
+        }
+
+        int* destino = nullptr;
+        if(arg == "--pistas") destino = &config.num_pistas;
+        else if(arg == "--avioes") destino = &config.num_avioes;
+        else if(arg == "--emergencias") destino = &config.percentual_emergencias;
+        else if(arg == "--variacao-desembarque") destino = &config.variacao_desembarque;
+        else if(arg == "--portoes") destino = &config.num_portoes;
+        else if(arg == "--vias-taxi") destino = &config.num_vias_taxi;
+
+        if(!destino || i + 1 >= argc) {
+            cerr << "Argumento inválido: " << arg << endl;
+            cerr << "Uso: " << argv[0] << " [--headless] [--pouso s] [--desembarque s] [--decolagem s]"
+                 << " [--intervalo s] [--pistas n] [--avioes n] [--politica nome]"
+                 << " [--chegadas regular|poisson|rajadas|diurna | --programacao arquivo.csv|.bin]"
+                 << " [--emergencias %] [--variacao-desembarque %] [--portoes n [--vias-taxi n] [--taxi s]]"
+                 << " [--metricas arquivo.json|.csv]"
+                 << " [--semente n] [--rastro arquivo] [--velocidade 1-1000]"
+                 << " [--gravar arquivo.grav | --reproduzir arquivo.grav]"
+                 << " [--aeroportos n [--voo-rede s] [--escalas n] [--threads n]]"
+                 << " [--varredura especificacao.txt [--saida tabela.csv|.json] [--threads n]]" << endl;
+            return false;
+        }
+        *destino = atoi(argv[++i]);
+    }
+
+    if(config.num_pistas < 1 || config.num_avioes < 0 || config.tempo_pouso_ms < 0 ||
+       config.tempo_desembarque_ms < 0 || config.tempo_decolagem_ms < 0 || config.tempo_entre_avioes_ms < 0 ||
+       config.percentual_emergencias < 0 || config.percentual_emergencias > 100 ||
+       config.variacao_desembarque < 0 || config.variacao_desembarque > 100 ||
+       config.num_portoes < 0 || config.num_vias_taxi < 0 || config.tempo_taxi_ms < 0) {
+        cerr << "Configuração inválida: é necessário ao menos uma pista, tempos e portões não negativos e percentuais entre 0 e 100." << endl;
+        return false;
+    }
+    if(opcoes.velocidade < RelogioSimulacao::ESCALA_MINIMA || opcoes.velocidade > RelogioSimulacao::ESCALA_MAXIMA) {
+        cerr << "--velocidade deve estar entre " << RelogioSimulacao::ESCALA_MINIMA << " e "
+             << RelogioSimulacao::ESCALA_MAXIMA << "." << endl;
+        return false;
+    }
+    if(opcoes.rede.aeroportos < 1 || opcoes.rede.escalas < 0 || opcoes.rede.tempo_voo_ms <= 0) {
+        cerr << "Rede inválida: é necessário ao menos um aeroporto, escalas não negativas e voo maior que zero." << endl;
+        return false;
+    }
+    if(config.chegadas == TipoChegadas::ARQUIVO) {
+        if(opcoes.rede.aeroportos > 1 || !opcoes.arquivo_varredura.empty()) {
+            cerr << "--programacao não pode ser usada com --aeroportos nem com --varredura." << endl;
+            return false;
+        }
+        string erro;
+        if(!criarFonteChegadas(config, 0, erro)) {
+            cerr << erro << endl;
+            return false;
+        }
+    }
+    if(!opcoes.arquivo_gravacao.empty() && !opcoes.arquivo_reproducao.empty()) {
+        cerr << "--gravar e --reproduzir não podem ser usados juntos." << endl;
+        return false;
+    }
+    return true;
+}
+
+// Grava as métricas no arquivo pedido em --metricas, se houver
+void salvarMetricas(const RegistroMetricas& metricas, const string& arquivo_metricas) {
+    if(arquivo_metricas.empty()) {
+        return;
+    }
+    if(metricas.salvar(arquivo_metricas)) {
+        cout << "Métricas gravadas em " << arquivo_metricas << ".\n";
+    } else {
+        cerr << "Falha ao gravar as métricas em " << arquivo_metricas << endl;
+    }
+}
+
+// Arquivo da n-ésima execução na mesma janela: a primeira usa o nome dado e as
+// seguintes ganham -2, -3, ... antes da extensão (voo.grav, voo-2.grav), para
+// uma nova simulação não apagar o rastro, a gravação e as métricas da anterior
+string arquivoDaExecucao(const string& caminho, int execucao) {
+    if(caminho.empty() || execucao <= 1) {
+        return caminho;
+    }
+    size_t inicio_nome = caminho.find_last_of("/\\");
+    inicio_nome = inicio_nome == string::npos ? 0 : inicio_nome + 1;
+    size_t ponto = caminho.find_last_of('.');
+    if(ponto == string::npos || ponto <= inicio_nome) {
+        ponto = caminho.size();
+    }
+    return caminho.substr(0, ponto) + "-" + to_string(execucao) + caminho.substr(ponto);
+}
+
+// Espera e maior fila de um estágio do aeroporto
+void imprimirEstagio(const char* nome, const EstatisticasEspera& espera, size_t fila_maxima) {
+    cout << "Estágio " << nome << ": " << espera.atendidos << " atendimentos, espera média " << espera.media_ms / 1000.0
+         << " s, p99 " << espera.p99_ms / 1000.0 << " s, máxima " << espera.maxima_ms / 1000.0 << " s; maior fila "
+         << fila_maxima << ".\n";
+}
+
+// Aviões da execução e como chegam
+string descreverChegadas(const Configuracao& config) {
+    if(config.chegadas == TipoChegadas::ARQUIVO) {
+        return "aviões da programação " + config.arquivo_chegadas;
+    }
+    string descricao = to_string(config.num_avioes) + " aviões";
+    if(config.chegadas != TipoChegadas::REGULAR) {
+        descricao += string(" com chegadas ") + nomeChegadas(config.chegadas);
+    }
+    return descricao;
+}
+
+// Executa a simulação sem janela, com relógio virtual, e imprime o resumo
+int executarHeadless(const Configuracao& config, const string& arquivo_metricas) {
+    cout << "Executando simulação headless: " << descreverChegadas(config) << ", "
+         << config.num_pistas << " pistas, política " << nomePolitica(config.politica_pistas)
+         << ", semente " << config.semente << ".\n";
+    if(config.num_portoes > 0) {
+        cout << "Desembarque em " << config.num_portoes << " portões, táxi de " << formatarSegundos(config.tempo_taxi_ms)
+             << " s por trecho em " << (config.num_vias_taxi > 0 ? to_string(config.num_vias_taxi) : string("vias sem limite"))
+             << (config.num_vias_taxi > 0 ? " vias.\n" : ".\n");
+    }
+
+    SimulacaoHeadless simulacao(config);
+    ResultadoSimulacao resultado = simulacao.executar();
+
+    double horas_simuladas = resultado.tempo_simulado_ms / 3600000.0;
+    cout << "Aviões concluídos: " << resultado.avioes_concluidos << "\n";
+    cout << "Eventos processados: " << resultado.eventos_processados << "\n";
+    cout << "Tempo simulado: " << resultado.tempo_simulado_ms / 1000.0 << " s (" << horas_simuladas << " h)\n";
+    cout << "Tempo de parede: " << resultado.tempo_parede_s << " s\n";
+    cout << "Espera por pista (" << resultado.politica << "): média " << resultado.espera.media_ms / 1000.0
+         << " s, p50 " << resultado.espera.p50_ms / 1000.0 << " s, p95 " << resultado.espera.p95_ms / 1000.0
+         << " s, p99 " << resultado.espera.p99_ms / 1000.0 << " s, máxima " << resultado.espera.maxima_ms / 1000.0 << " s\n";
+    for(size_t i = 0; i < resultado.ocupacao_pistas_ms.size(); ++i) {
+        double fracao = resultado.tempo_simulado_ms > 0
+            ? 100.0 * resultado.ocupacao_pistas_ms[i] / resultado.tempo_simulado_ms : 0.0;
+        cout << "Pista " << i + 1 << " ocupada " << fracao << "% do tempo.\n";
+    }
+    if(config.num_portoes > 0) {
+        imprimirEstagio("pistas", resultado.espera, resultado.fila_maxima_pistas);
+        if(config.num_vias_taxi > 0) {
+            imprimirEstagio("vias de táxi", resultado.espera_taxi, resultado.fila_maxima_taxi);
+        }
+        imprimirEstagio("portões", resultado.espera_portoes, resultado.fila_maxima_portoes);
+    }
+    salvarMetricas(simulacao.metricas(), arquivo_metricas);
+    return 0;
+}
+
+// Executa todas as combinações da varredura em paralelo e grava a tabela agregada
+int executarModoVarredura(const Configuracao& base, const OpcoesExecucao& opcoes) {
+    ifstream arquivo(opcoes.arquivo_varredura);
+    if(!arquivo) {
+        cerr << "Não foi possível abrir " << opcoes.arquivo_varredura << endl;
+        return 1;
+    }
+    EspecificacaoVarredura especificacao;
+    string erro;
+    if(!lerVarredura(arquivo, base, especificacao, erro)) {
+        cerr << opcoes.arquivo_varredura << ": " << erro << endl;
+        return 1;
+    }
+
+    vector<Configuracao> configuracoes = expandirVarredura(especificacao);
+    unsigned threads = opcoes.threads ? opcoes.threads : max(1u, thread::hardware_concurrency());
+    cout << "Varredura: " << configuracoes.size() << " execuções headless em " << threads << " threads.\n";
+
+    auto inicio = chrono::steady_clock::now();
+    vector<ResultadoSimulacao> resultados = executarVarredura(configuracoes, threads);
+    double duracao = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    if(!salvarVarredura(opcoes.arquivo_saida, configuracoes, resultados)) {
+        cerr << "Falha ao gravar a tabela em " << opcoes.arquivo_saida << endl;
+        return 1;
+    }
+    cout << "Tabela gravada em " << opcoes.arquivo_saida << " (" << duracao << " s de parede).\n";
+    return 0;
+}
+
+// Simula a rede de aeroportos em paralelo, sem janela, e imprime o resumo
+int executarRede(const Configuracao& config, const OpcoesExecucao& opcoes) {
+    ConfiguracaoRede rede = opcoes.rede;
+    rede.threads = opcoes.threads;
+    cout << "Executando rede headless: " << rede.aeroportos << " aeroportos com " << descreverChegadas(config)
+         << " e " << config.num_pistas << " pistas cada, " << rede.escalas << " escalas por avião, voo de "
+         << formatarSegundos(rede.tempo_voo_ms) << " s entre vizinhos, política " << nomePolitica(config.politica_pistas)
+         << ", semente " << config.semente << ".\n";
+    if(!opcoes.arquivo_metricas.empty()) {
+        cerr << "--metricas vale só para um aeroporto; ignorado na rede." << endl;
+    }
+
+    SimulacaoRede simulacao(config, rede);
+    ResultadoRede resultado = simulacao.executar();
+
+    cout << "Threads: " << resultado.threads << "\n";
+    cout << "Aviões concluídos: " << resultado.avioes_concluidos << " (" << resultado.pousos << " pousos, "
+         << resultado.transferencias << " voos entre aeroportos)\n";
+    cout << "Eventos processados: " << resultado.eventos_processados << "\n";
+    cout << "Janelas sincronizadas: " << resultado.janelas << " (" << resultado.rodadas_extras
+         << " rodadas extras com anel cheio)\n";
+    cout << "Tempo simulado: " << resultado.tempo_simulado_ms / 1000.0 << " s ("
+         << resultado.tempo_simulado_ms / 3600000.0 << " h)\n";
+    cout << "Tempo de parede: " << resultado.tempo_parede_s << " s\n";
+    cout << "Espera por pista (todos os aeroportos): média " << resultado.espera.media_ms / 1000.0 << " s, p50 "
+         << resultado.espera.p50_ms / 1000.0 << " s, p95 " << resultado.espera.p95_ms / 1000.0 << " s, p99 "
+         << resultado.espera.p99_ms / 1000.0 << " s, máxima " << resultado.espera.maxima_ms / 1000.0 << " s\n";
+    for(size_t i = 0; i < resultado.aeroportos.size(); ++i) {
+        const ResultadoSimulacao& aeroporto = resultado.aeroportos[i];
+        cout << "Aeroporto " << i + 1 << ": " << aeroporto.espera.atendidos << " pousos, espera média "
+             << aeroporto.espera.media_ms / 1000.0 << " s, p99 " << aeroporto.espera.p99_ms / 1000.0 << " s.\n";
+    }
+    return 0;
+}
+
+// Tempo como hh:mm:ss, para a linha do tempo da reprodução
+string formatarRelogio(int64_t ms) {
+    int64_t segundos = ms / 1000;
+    char texto[32];
+    snprintf(texto, sizeof(texto), "%02lld:%02lld:%02lld", static_cast<long long>(segundos / 3600),
+             static_cast<long long>(segundos / 60 % 60), static_cast<long long>(segundos % 60));
+    return texto;
+}
+
+// Salto das setas durante a reprodução
+constexpr int64_t SALTO_REPRODUCAO_MS = 10000;
+
+// Reproduz uma gravação na janela. A posição avança com o tempo real vezes a
+// velocidade ("+" e "-", como na simulação); espaço pausa, as setas saltam
+// 10 s, Home e End vão ao início e ao fim, e clicar ou arrastar na barra
+// inferior leva a qualquer instante. Cada quadro pede ao reprodutor só o
+// estado do instante desenhado, então saltar custa o mesmo que avançar.
+int executarReproducao(SDL_Renderer* renderer, TTF_Font* font, ReprodutorSimulacao& reprodutor, double velocidade,
+                       LoteTriangulos& lote_avioes, const SDL_Color& branco, const SDL_Color& azul_celar,
+                       const SDL_Color& cinza_escuro, const SDL_Color& cinza) {
+    // O mesmo solo da execução gravada
+    vector<Runway> pistas;
+    vector<Runway> portoes;
+    montarPistas(reprodutor.numPistas(), pistas, reprodutor.faixaPistas());
+    montarPortoes(reprodutor.numPortoes(), portoes);
+    const double duracao_ms = static_cast<double>(reprodutor.duracaoMs());
+    SDL_Rect barra = {10, ALTURA_JANELA - 20, LARGURA_JANELA - 20, 10};
+    auto posicaoNaBarra = [&](int x) {
+        return duracao_ms * min(1.0, max(0.0, static_cast<double>(x - barra.x) / barra.w));
+    };
+
+    RitmoQuadros ritmo;
+    double escala = velocidade;
+    double posicao_ms = 0.0;
+    bool pausado = false;
+    bool arrastando = false;
+    bool redesenhar = true;
+    RitmoQuadros::Relogio::time_point anterior = RitmoQuadros::Relogio::now();
+
+    bool rodando = true;
+    while(rodando) {
+        SDL_Event evento;
+        int espera_ms = ritmo.msAtePrazo();
+        bool ha_evento = espera_ms > 0 ? SDL_WaitEventTimeout(&evento, espera_ms) : SDL_PollEvent(&evento);
+        while(ha_evento) {
+            redesenhar = true;
+            if(evento.type == SDL_QUIT) {
+                rodando = false;
+            } else if(evento.type == SDL_KEYDOWN) {
+                SDL_Keycode tecla = evento.key.keysym.sym;
+                if(tecla == SDLK_PLUS || tecla == SDLK_EQUALS || tecla == SDLK_KP_PLUS) {
+                    escala = proximaEscala(escala);
+                } else if(tecla == SDLK_MINUS || tecla == SDLK_KP_MINUS) {
+                    escala = escalaAnterior(escala);
+                } else if(tecla == SDLK_SPACE) {
+                    pausado = !pausado;
+                } else if(tecla == SDLK_LEFT) {
+                    posicao_ms -= SALTO_REPRODUCAO_MS;
+                } else if(tecla == SDLK_RIGHT) {
+                    posicao_ms += SALTO_REPRODUCAO_MS;
+                } else if(tecla == SDLK_HOME) {
+                    posicao_ms = 0.0;
+                } else if(tecla == SDLK_END) {
+                    posicao_ms = duracao_ms;
                 }
+            } else if(evento.type == SDL_MOUSEBUTTONDOWN && mouse_noRetangulo(evento.button.x, evento.button.y, barra)) {
+                arrastando = true;
+                posicao_ms = posicaoNaBarra(evento.button.x);
+            } else if(evento.type == SDL_MOUSEMOTION && arrastando) {
+                posicao_ms = posicaoNaBarra(evento.motion.x);
+            } else if(evento.type == SDL_MOUSEBUTTONUP) {
+                arrastando = false;
             }
+            ha_evento = SDL_PollEvent(&evento);
+        }
+
+        if(ritmo.msAtePrazo() > 0) {
+            continue;
+        }
+        ritmo.esperarPrazo();
+
+        // A posição anda com o tempo real desde o quadro anterior e para no fim da gravação
+        RitmoQuadros::Relogio::time_point agora = RitmoQuadros::Relogio::now();
+        if(!pausado && !arrastando) {
+            posicao_ms += chrono::duration<double, milli>(agora - anterior).count() * escala;
+        }
+        anterior = agora;
+        posicao_ms = min(duracao_ms, max(0.0, posicao_ms));
+        if((pausado || posicao_ms >= duracao_ms) && !redesenhar) {
+            ritmo.pularQuadro();
+            continue;
         }
+
+        ritmo.iniciarQuadro();
+        const QuadroSimulacao& quadro = reprodutor.quadroEm(static_cast<int64_t>(posicao_ms));
+        desenharCena(renderer, font, pistas, portoes, quadro, lote_avioes, branco, azul_celar, cinza_escuro, cinza);
+        renderizarTextoVariavel(renderer, font, "Reprodução   Velocidade: " + to_string(static_cast<int>(escala)) + "x   " +
+                                formatarRelogio(static_cast<int64_t>(posicao_ms)) + " / " +
+                                formatarRelogio(reprodutor.duracaoMs()) + (pausado ? "   (pausado)" : ""), 10, 50, branco);
+
+        // Linha do tempo: a parte branca é o que já foi reproduzido
+        SDL_SetRenderDrawColor(renderer, cinza.r, cinza.g, cinza.b, cinza.a);
+        SDL_RenderFillRect(renderer, &barra);
+        SDL_Rect reproduzido = barra;
+        reproduzido.w = duracao_ms > 0 ? static_cast<int>(barra.w * posicao_ms / duracao_ms) : barra.w;
+        SDL_SetRenderDrawColor(renderer, branco.r, branco.g, branco.b, branco.a);
+        SDL_RenderFillRect(renderer, &reproduzido);
+
+        SDL_RenderPresent(renderer);
+        ritmo.concluirQuadro();
+        redesenhar = false;
     }
+    return 0;
+}
+
+// Fim de uma execução na janela, concluída ou interrompida: para os aviões,
+// fecha o rastro e a gravação e imprime o resumo. O pool continua disponível.
+void encerrarExecucao(RecursosCompartilhados& recursos, PoolTarefas& pool, const RitmoQuadros& ritmo,
+                      const OpcoesExecucao& opcoes) {
+    // Cancela as esperas do pool e descarta os aviões restantes; volta em
+    // milissegundos, só esperando os passos em andamento
+    interromperSimulacao(recursos, pool);
+
+    // Grava os últimos eventos do rastro
+    recursos.rastro.encerrar();
+
+    // Completa a gravação com o índice (o tick já parou)
+    if(recursos.gravacao.ativo()) {
+        if(recursos.gravacao.encerrar()) {
+            cout << "Gravação: " << recursos.gravacao.quadros() << " quadros, " << recursos.gravacao.bytes() / 1e6
+                 << " MB em " << opcoes.arquivo_gravacao << ".\n";
+        } else {
+            cerr << "Falha ao gravar " << opcoes.arquivo_gravacao << endl;
+        }
+    }
+
+    // Esperas por pista na política escolhida
+    if(recursos.alocador_pistas) {
+        EstatisticasEspera espera = recursos.alocador_pistas->estatisticas();
+        cout << "Política " << recursos.alocador_pistas->nomePolitica() << ": espera média "
+             << espera.media_ms / 1000.0 << " s, p99 " << espera.p99_ms / 1000.0 << " s, máxima "
+             << espera.maxima_ms / 1000.0 << " s.\n";
+        if(recursos.alocador_portoes) {
+            imprimirEstagio("pistas", espera, recursos.alocador_pistas->filaMaxima());
+            if(recursos.alocador_vias) {
+                imprimirEstagio("vias de táxi", recursos.alocador_vias->estatisticas(), recursos.alocador_vias->filaMaxima());
+            }
+            imprimirEstagio("portões", recursos.alocador_portoes->estatisticas(), recursos.alocador_portoes->filaMaxima());
+        }
+
+        concluirMetricas(recursos);
+        salvarMetricas(recursos.metricas, opcoes.arquivo_metricas);
+    }
+
+    // Tempo dos quadros desenhados durante a simulação
+    if(ritmo.custo().contagem() > 0) {
+        cout << "Quadros: " << ritmo.custo().contagem() << " desenhados, " << ritmo.quadrosPulados()
+             << " pulados sem mudança; custo p50 " << ritmo.custo().percentil(50) / 1000.0 << " ms, p99 "
+             << ritmo.custo().percentil(99) / 1000.0 << " ms; intervalo p50 " << ritmo.intervalo().percentil(50) / 1000.0
+             << " ms, p99 " << ritmo.intervalo().percentil(99) / 1000.0 << " ms, máximo "
+             << ritmo.intervalo().maximo() / 1000.0 << " ms.\n";
+    }
+
+    // Relatório de contenção do mutex dos aviões (o renderer não o disputa mais)
+    cout << "Mutex dos aviões: " << recursos.contencao_avioes.aquisicoes << " aquisições, "
+         << recursos.contencao_avioes.contendidas << " com espera, "
+         << recursos.contencao_avioes.espera_ns / 1e6 << " ms esperando no total.\n";
+
+    // Pico de aviões simultâneos, arredondado para os blocos da arena
+    cout << "Arena dos aviões: " << recursos.arena_avioes.capacidade() << " posições reservadas.\n";
 }
 
 int main(int argc, char* argv[]) {
-    // Inicializa gerador de números aleatórios
-    srand(static_cast<unsigned int>(time(nullptr)));
+    // Configurações
+    Configuracao config;
+    OpcoesExecucao opcoes;
+    if(!lerArgumentos(argc, argv, config, opcoes)) {
+        return 1;
+    }
+
+    // Varredura de parâmetros: várias execuções headless, sem janela
+    if(!opcoes.arquivo_varredura.empty()) {
+        return executarModoVarredura(config, opcoes);
+    }
+
+    // Rede de aeroportos: sempre sem janela, que desenha um aeroporto só
+    if(opcoes.rede.aeroportos > 1) {
+        return executarRede(config, opcoes);
+    }
+
+    // Modo headless: não depende de janela nem de relógio de parede
+    if(opcoes.headless) {
+        return executarHeadless(config, opcoes.arquivo_metricas);
+    }
+    if(config.num_pistas > MAX_PISTAS || config.num_portoes > MAX_PISTAS) {
+        cerr << "A versão gráfica desenha no máximo " << MAX_PISTAS << " pistas e " << MAX_PISTAS
+             << " portões (sem limite com --headless)." << endl;
+        return 1;
+    }
+
+    // Reprodução: a gravação é aberta antes da janela, para falhar cedo
+    ReprodutorSimulacao reprodutor;
+    bool reproduzindo = !opcoes.arquivo_reproducao.empty();
+    if(reproduzindo) {
+        string erro;
+        if(!reprodutor.abrir(opcoes.arquivo_reproducao, erro)) {
+            cerr << opcoes.arquivo_reproducao << ": " << erro << endl;
+            return 1;
+        }
+        cout << "Reproduzindo " << opcoes.arquivo_reproducao << ": " << reprodutor.quadros() << " quadros, "
+             << formatarRelogio(reprodutor.duracaoMs()) << ", " << reprodutor.numPistas() << " pistas"
+             << (reprodutor.numPortoes() > 0 ? ", " + to_string(reprodutor.numPortoes()) + " portões" : "")
+             << (reprodutor.encerradaCorretamente() ? "" : " (gravação interrompida, índice reconstruído)") << ".\n";
+    } else {
+        // Sem --semente, cada execução da janela usa uma semente nova; ela é impressa para poder ser repetida
+        if(config.semente == 0) {
+            config.semente = static_cast<uint64_t>(time(nullptr));
+        }
+        cout << "Semente: " << config.semente << "\n";
+    }
 
     // Inicializa SDL
     if(SDL_Init(SDL_INIT_VIDEO) != 0) {
@@ -281,24 +914,54 @@ int main(int argc, char* argv[]) {
     SDL_Color cinza_escuro = {50, 50, 50, 255};
     SDL_Color cinza = {169, 169, 169, 255};
 
+    // Vértices dos aviões, reaproveitados entre quadros
+    LoteTriangulos lote_avioes;
+
+    // Reprodução: a mesma janela desenha a gravação, sem simulação
+    if(reproduzindo) {
+        int codigo = executarReproducao(renderer, font, reprodutor, opcoes.velocidade, lote_avioes, branco, azul_celar,
+                                        cinza_escuro, cinza);
+        liberarCacheTexto();
+        TTF_CloseFont(font);
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        TTF_Quit();
+        SDL_Quit();
+        return codigo;
+    }
+
     // Estado inicial
     EstadoApp estado_atual = EstadoApp::CONFIGURACAO;
 
-    // Configurações
-    Configuracao config;
+    // Pool de threads que executa os aviões como tarefas (uma thread por núcleo),
+    // com os prazos no relógio da simulação; os dois servem a todas as execuções
+    RelogioSimulacao relogio;
+    relogio.definirEscala(opcoes.velocidade);
+    unique_ptr<PoolTarefas> pool(new PoolTarefas(relogio));
+    cout << "Pool de tarefas criado com " << pool->numThreads() << " threads.\n";
 
-    // Recursos compartilhados
-    RecursosCompartilhados recursos;
-    recursos.semaforo_pistas = nullptr; // Será inicializado ao iniciar a simulação
+    // Recursos da execução em andamento, criados a cada Play, e as opções dela
+    // (com os arquivos numerados a partir da segunda execução)
+    unique_ptr<RecursosCompartilhados> recursos;
+    OpcoesExecucao opcoes_execucao = opcoes;
+    int execucoes = 0;
 
-    // Threads de aviões
-    vector<pthread_t> threads;
+    // Ritmo dos quadros da simulação, com os tempos de quadro exportados nas métricas
+    RitmoQuadros ritmo;
+    bool redesenhar = true;     // Algum evento pode ter mudado a tela
+    bool encerrando = false;    // Simulação concluída: a janela fica aberta mais um pouco
+    RitmoQuadros::Relogio::time_point fechar_em;
 
     // Loop principal
     bool rodando = true;
     while (rodando) {
+        // Espera eventos até o prazo do próximo quadro; a tela de configuração
+        // não muda sem um evento, então ali a espera é longa
         SDL_Event evento;
-        while(SDL_PollEvent(&evento)) {
+        int espera_ms = estado_atual == EstadoApp::SIMULACAO ? ritmo.msAtePrazo() : ESPERA_OCIOSA_MS;
+        bool ha_evento = espera_ms > 0 ? SDL_WaitEventTimeout(&evento, espera_ms) : SDL_PollEvent(&evento);
+        while(ha_evento) {
+            redesenhar = true;
             if(evento.type == SDL_QUIT) {
                 cout << "Evento SDL_QUIT recebido. Encerrando...\n";
                 rodando = false;
@@ -315,27 +978,27 @@ int main(int argc, char* argv[]) {
                         if(mouse_noRetangulo(mouseX, mouseY, botoes_mais[i])) {
                             switch(i) {
                                 case 0: 
-                                    config.tempo_pouso++; 
-                                    cout << "Tempo de Pouso incrementado para " << config.tempo_pouso << " segundos." << endl;
+                                    config.tempo_pouso_ms += 1000; 
+                                    cout << "Tempo de Pouso incrementado para " << formatarSegundos(config.tempo_pouso_ms) << " segundos." << endl;
                                     break;
                                 case 1: 
-                                    config.tempo_desembarque++; 
-                                    cout << "Tempo de Desembarque incrementado para " << config.tempo_desembarque << " segundos." << endl;
+                                    config.tempo_desembarque_ms += 1000; 
+                                    cout << "Tempo de Desembarque incrementado para " << formatarSegundos(config.tempo_desembarque_ms) << " segundos." << endl;
                                     break;
                                 case 2: 
-                                    config.tempo_decolagem++; 
-                                    cout << "Tempo de Decolagem incrementado para " << config.tempo_decolagem << " segundos." << endl;
+                                    config.tempo_decolagem_ms += 1000; 
+                                    cout << "Tempo de Decolagem incrementado para " << formatarSegundos(config.tempo_decolagem_ms) << " segundos." << endl;
                                     break;
                                 case 3: 
-                                    config.tempo_entre_avioes++; 
-                                    cout << "Tempo entre Aviões incrementado para " << config.tempo_entre_avioes << " segundos." << endl;
+                                    config.tempo_entre_avioes_ms += 1000; 
+                                    cout << "Tempo entre Aviões incrementado para " << formatarSegundos(config.tempo_entre_avioes_ms) << " segundos." << endl;
                                     break;
                                 case 4: // Número de Pistas
-                                    if(config.num_pistas < 3) { // Impõe máximo de 3
+                                    if(config.num_pistas < MAX_PISTAS) {
                                         config.num_pistas++; 
                                         cout << "Número de Pistas incrementado para " << config.num_pistas << endl;
                                     } else {
-                                        cout << "Máximo de 3 Pistas já atingido.\n";
+                                        cout << "Máximo de " << MAX_PISTAS << " Pistas já atingido.\n";
                                     }
                                     break;
                                 case 5: 
@@ -351,27 +1014,27 @@ int main(int argc, char* argv[]) {
                         if(mouse_noRetangulo(mouseX, mouseY, botoes_menos[i])) {
                             switch(i) {
                                 case 0: 
-                                    if(config.tempo_pouso > 1) {
-                                        config.tempo_pouso--; 
-                                        cout << "Tempo de Pouso decrementado para " << config.tempo_pouso << " segundos." << endl;
+                                    if(config.tempo_pouso_ms > 1000) {
+                                        config.tempo_pouso_ms = max<int64_t>(1000, config.tempo_pouso_ms - 1000); 
+                                        cout << "Tempo de Pouso decrementado para " << formatarSegundos(config.tempo_pouso_ms) << " segundos." << endl;
                                     }
                                     break;
                                 case 1: 
-                                    if(config.tempo_desembarque > 1) {
-                                        config.tempo_desembarque--; 
-                                        cout << "Tempo de Desembarque decrementado para " << config.tempo_desembarque << " segundos." << endl;
+                                    if(config.tempo_desembarque_ms > 1000) {
+                                        config.tempo_desembarque_ms = max<int64_t>(1000, config.tempo_desembarque_ms - 1000); 
+                                        cout << "Tempo de Desembarque decrementado para " << formatarSegundos(config.tempo_desembarque_ms) << " segundos." << endl;
                                     }
                                     break;
                                 case 2: 
-                                    if(config.tempo_decolagem > 1) {
-                                        config.tempo_decolagem--; 
-                                        cout << "Tempo de Decolagem decrementado para " << config.tempo_decolagem << " segundos." << endl;
+                                    if(config.tempo_decolagem_ms > 1000) {
+                                        config.tempo_decolagem_ms = max<int64_t>(1000, config.tempo_decolagem_ms - 1000); 
+                                        cout << "Tempo de Decolagem decrementado para " << formatarSegundos(config.tempo_decolagem_ms) << " segundos." << endl;
                                     }
                                     break;
                                 case 3: 
-                                    if(config.tempo_entre_avioes > 4) { // Alterado para > 4
-                                        config.tempo_entre_avioes--; 
-                                        cout << "Tempo entre Aviões decrementado para " << config.tempo_entre_avioes << " segundos." << endl;
+                                    if(config.tempo_entre_avioes_ms > 4000) { // Alterado para > 4
+                                        config.tempo_entre_avioes_ms = max<int64_t>(4000, config.tempo_entre_avioes_ms - 1000); 
+                                        cout << "Tempo entre Aviões decrementado para " << formatarSegundos(config.tempo_entre_avioes_ms) << " segundos." << endl;
                                     }
                                     else {
                                         cout << "Tempo entre Aviões não pode ser menor que 4 segundos." << endl;
@@ -397,97 +1060,123 @@ int main(int argc, char* argv[]) {
                     if(mouse_noRetangulo(mouseX, mouseY, botao_play)) {
                         cout << "Mudando para o estado SIMULACAO.\n";
                         estado_atual = EstadoApp::SIMULACAO;
+                        recursos.reset(new RecursosCompartilhados(relogio));
+                        recursos->metricas.registrarQuadros(&ritmo.custo(), &ritmo.intervalo());
+                        execucoes++;
+                        opcoes_execucao.arquivo_rastro = arquivoDaExecucao(opcoes.arquivo_rastro, execucoes);
+                        opcoes_execucao.arquivo_gravacao = arquivoDaExecucao(opcoes.arquivo_gravacao, execucoes);
+                        opcoes_execucao.arquivo_metricas = arquivoDaExecucao(opcoes.arquivo_metricas, execucoes);
 
-                        // Inicializar semáforo
-                        recursos.semaforo_pistas = new Semaforo(config.num_pistas);
-                        cout << "Semáforo inicializado com " << config.num_pistas << " pistas.\n";
-
-                        // Inicializar pistas
-                        int largura_pista = 200;
-                        int altura_pista = 20;
-                        int espaco = 50;
-                        int largura_total = config.num_pistas * largura_pista + (config.num_pistas - 1) * espaco;
-                        int inicioX = (LARGURA_JANELA - largura_total) / 2;
-                        int Y_pista = ALTURA_JANELA - 100; // Posicionar pistas sobre o solo
-
-                        // Criar pistas e adicionar a RecursosCompartilhados
-                        for(int i = 0; i < config.num_pistas; ++i) {
-                            SDL_Rect retangulo_pista = { inicioX + i * (largura_pista + espaco), Y_pista, largura_pista, altura_pista };
-                            recursos.pistas.emplace_back(i + 1, retangulo_pista);
-                        }
+                        // Inicializar pistas e portões (com portões, as pistas ocupam só a metade de cima do solo)
+                        int faixa_pistas = config.num_portoes > 0 ? FAIXA_PISTAS_COM_PORTOES : 90;
+                        montarPistas(config.num_pistas, recursos->pistas, faixa_pistas);
+                        montarPortoes(config.num_portoes, recursos->portoes);
 
                         cout << config.num_pistas << " pistas inicializadas.\n";
 
-                        // Criar threads para cada avião sem dormir
-                        threads.resize(config.num_avioes);
-                        for (int i = 0; i < config.num_avioes; ++i) {
-                            AviaoData* dados_aviao = new AviaoData;
-                            dados_aviao->id = i + 1;
-                            dados_aviao->tempo_pouso = config.tempo_pouso;
-                            dados_aviao->tempo_desembarque = config.tempo_desembarque;
-                            dados_aviao->tempo_decolagem = config.tempo_decolagem;
-                            dados_aviao->pistas = recursos.semaforo_pistas;
-                            dados_aviao->avioes = &recursos.avioes;
-                            dados_aviao->pistasList = &recursos.pistas; // Passa pistas para as threads dos aviões
-                            dados_aviao->mutex_avioes = &recursos.mutex_avioes;
-                            dados_aviao->atraso_inicio = i * config.tempo_entre_avioes; // Atribui atraso de início
-
-                            if (pthread_create(&threads[i], NULL, aviao, dados_aviao) != 0) {
-                                cerr << "Erro ao criar thread para o avião " << i + 1 << endl;
-                                delete dados_aviao;
+                        // Os aviões registram o ciclo de vida no rastro binário em vez do terminal
+                        if(!opcoes_execucao.arquivo_rastro.empty()) {
+                            if(recursos->rastro.abrir(opcoes_execucao.arquivo_rastro)) {
+                                cout << "Rastro dos aviões em " << opcoes_execucao.arquivo_rastro
+                                     << " (leia com decodificar_rastro).\n";
+                            } else {
+                                cerr << "Não foi possível criar o rastro " << opcoes_execucao.arquivo_rastro << endl;
                             }
-                            // Removido sleep para evitar bloqueio da thread principal
                         }
+
+                        // Cada quadro publicado pelo tick vai para a gravação
+                        if(!opcoes_execucao.arquivo_gravacao.empty()) {
+                            if(recursos->gravacao.abrir(opcoes_execucao.arquivo_gravacao, config.num_pistas,
+                                                        config.num_portoes, faixa_pistas)) {
+                                cout << "Gravando a simulação em " << opcoes_execucao.arquivo_gravacao
+                                     << " (reproduza com --reproduzir).\n";
+                            } else {
+                                cerr << "Não foi possível criar a gravação " << opcoes_execucao.arquivo_gravacao << endl;
+                            }
+                        }
+
+                        iniciarSimulacao(config, *recursos, *pool);
+                        ritmo.reiniciar();
                     }
                 }
             }
             else if(estado_atual == EstadoApp::SIMULACAO) {
-                // Lidar com eventos específicos da simulação, se houver (ex: pausar, reiniciar)
-                // Atualmente, nenhum tratamento adicional
+                // "+" e "-" mudam a velocidade do relógio (1x a 1000x) sem mudar o resultado
+                if(evento.type == SDL_KEYDOWN) {
+                    SDL_Keycode tecla = evento.key.keysym.sym;
+                    double escala = relogio.escala();
+                    if(tecla == SDLK_PLUS || tecla == SDLK_EQUALS || tecla == SDLK_KP_PLUS) {
+                        escala = proximaEscala(escala);
+                    } else if(tecla == SDLK_MINUS || tecla == SDLK_KP_MINUS) {
+                        escala = escalaAnterior(escala);
+                    }
+                    if(escala != relogio.escala()) {
+                        relogio.definirEscala(escala);
+                        cout << "Velocidade da simulação: " << escala << "x\n";
+                    }
+
+                    // "R" interrompe a simulação e volta à configuração na mesma janela
+                    if(tecla == SDLK_r) {
+                        cout << "Simulação interrompida. Voltando à configuração.\n";
+                        encerrarExecucao(*recursos, *pool, ritmo, opcoes_execucao);
+                        recursos.reset();
+                        estado_atual = EstadoApp::CONFIGURACAO;
+                        encerrando = false;
+                    }
+                }
             }
+            ha_evento = SDL_PollEvent(&evento);
         }
 
-        // Renderização baseada no estado atual
+        // Configuração: redesenha só depois de um evento
         if(estado_atual == EstadoApp::CONFIGURACAO) {
-            renderizarConfiguracao(renderer, font, config, botoes_mais, botoes_menos, botao_play, preto, verde, vermelho, branco);
-        }
-        else if(estado_atual == EstadoApp::SIMULACAO) {
-            renderizarSimulacao(renderer, font, config, recursos, branco, azul_celar, cinza_escuro, cinza);
+            if(redesenhar) {
+                renderizarConfiguracao(renderer, font, config, botoes_mais, botoes_menos, botao_play, preto, verde, vermelho, branco);
+                SDL_RenderPresent(renderer);
+                redesenhar = false;
+            }
+            continue;
         }
 
-        // Apresenta o renderer
-        SDL_RenderPresent(renderer);
+        // Simulação: um evento antes do prazo volta para a espera; o resto abaixo
+        // de 1 ms é dormido aqui (60 quadros por segundo reais, qualquer que seja a escala do relógio)
+        if(ritmo.msAtePrazo() > 0) {
+            continue;
+        }
+        ritmo.esperarPrazo();
 
-        // Delay para controlar taxa de quadros
-        SDL_Delay(16); // Aproximadamente 60 FPS
-
-        // Verifica se a simulação terminou
-        if(estado_atual == EstadoApp::SIMULACAO) {
-            // Bloqueia a lista de aviões para verificar se está vazia
-            {
-                lock_guard<mutex> lock(recursos.mutex_avioes);
-                if(recursos.avioes.empty()) {
-                    cout << "A simulação terminou, obrigado por viajar conosco...\n";
-                    // Espera alguns segundos antes de fechar a simulação
-                    sleep(2);
-                    rodando = false;
-                }
-            }
+        // Desenha se o tick publicou um quadro novo ou se houve evento
+        if(recursos->quadros.atualizar() || redesenhar) {
+            ritmo.iniciarQuadro();
+            renderizarSimulacao(renderer, font, config, *recursos, lote_avioes, branco, azul_celar, cinza_escuro, cinza);
+            SDL_RenderPresent(renderer);
+            ritmo.concluirQuadro();
+            redesenhar = false;
+        } else {
+            ritmo.pularQuadro();
         }
-    }
 
-    // Limpeza
-    // Se estiver no estado SIMULACAO, destruir semáforo
-    if(recursos.semaforo_pistas) {
-        delete recursos.semaforo_pistas;
+        // A simulação termina quando todos os aviões concluíram; a janela
+        // continua respondendo aos eventos por alguns segundos antes de fechar
+        if(!encerrando && recursos->avioes_pendentes == 0) {
+            cout << "A simulação terminou, obrigado por viajar conosco...\n";
+            encerrando = true;
+            fechar_em = RitmoQuadros::Relogio::now() + chrono::seconds(2);
+        }
+        if(encerrando && RitmoQuadros::Relogio::now() >= fechar_em) {
+            rodando = false;
+        }
     }
 
-    // Esperar todas as threads de aviões terminarem
-    for(auto& thread : threads) {
-        pthread_join(thread, NULL);
+    // Interrompe a simulação que ainda estiver em andamento e imprime o resumo
+    if(recursos) {
+        encerrarExecucao(*recursos, *pool, ritmo, opcoes_execucao);
     }
+    recursos.reset();
+    pool.reset();
 
     // Limpar recursos SDL
+    liberarCacheTexto();
     TTF_CloseFont(font);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
@@ -0,0 +1,78 @@
+#ifndef MAPA_BITS_H
+#define MAPA_BITS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Conjunto de bits atômico (1 = ocupado). Reservar e liberar são uma única
+// operação atômica na palavra do bit: a reserva acha o primeiro livre com
+// find-first-set sobre o complemento e o marca com CAS, sem lock.
+class MapaBitsAtomico {
+public:
+    explicit MapaBitsAtomico(size_t num_bits)
+        : num_bits(num_bits), num_palavras((num_bits + 63) / 64),
+          palavras(new std::atomic<uint64_t>[(num_bits + 63) / 64]) {
+        for(size_t p = 0; p < num_palavras; ++p) {
+            palavras[p].store(0, std::memory_order_relaxed);
+        }
+        // Bits além do último recurso ficam sempre ocupados
+        if(num_bits % 64) {
+            palavras[num_palavras - 1].store(~0ULL << (num_bits % 64), std::memory_order_relaxed);
+        }
+    }
+
+    size_t tamanho() const { return num_bits; }
+
+    // Reserva o primeiro bit livre e devolve seu índice, ou -1 se todos estão ocupados
+    int reservarPrimeiroLivre() {
+        for(size_t p = 0; p < num_palavras; ++p) {
+            uint64_t atual = palavras[p].load(std::memory_order_relaxed);
+            while(~atual) {
+                int bit = __builtin_ctzll(~atual);
+                if(palavras[p].compare_exchange_weak(atual, atual | (1ULL << bit),
+                                                     std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    return static_cast<int>(p * 64 + bit);
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Reserva um bit específico; falha se ele já estava ocupado
+    bool reservar(size_t i) {
+        uint64_t mascara = 1ULL << (i % 64);
+        return !(palavras[i / 64].fetch_or(mascara, std::memory_order_acq_rel) & mascara);
+    }
+
+    void liberar(size_t i) {
+        palavras[i / 64].fetch_and(~(1ULL << (i % 64)), std::memory_order_seq_cst);
+    }
+
+    bool ocupado(size_t i) const {
+        return (palavras[i / 64].load(std::memory_order_acquire) >> (i % 64)) & 1;
+    }
+
+    // Cópia instantânea de cada palavra, para percorrer os livres sem reler os atômicos
+    uint64_t palavra(size_t p) const { return palavras[p].load(std::memory_order_acquire); }
+    size_t numPalavras() const { return num_palavras; }
+
+    void copiar(std::vector<char>& destino) const {
+        destino.resize(num_bits);
+        for(size_t p = 0; p < num_palavras; ++p) {
+            uint64_t bits = palavra(p);
+            for(size_t b = 0; b < 64 && p * 64 + b < num_bits; ++b) {
+                destino[p * 64 + b] = static_cast<char>((bits >> b) & 1);
+            }
+        }
+    }
+
+private:
+    size_t num_bits;
+    size_t num_palavras;
+    std::unique_ptr<std::atomic<uint64_t>[]> palavras;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef MAPA_SLOTS_H
+#define MAPA_SLOTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Handle estável para um elemento do MapaSlots. A geração invalida handles
+// antigos quando o slot é reaproveitado por outro elemento.
+struct HandleSlot {
+    uint32_t indice = UINT32_MAX;
+    uint32_t geracao = 0;
+
+    bool valido() const { return indice != UINT32_MAX; }
+};
+
+// Mapa de slots com índices geracionais: inserção, busca e remoção em O(1),
+// com os valores guardados de forma contígua para iteração rápida.
+template<typename T>
+class MapaSlots {
+public:
+    // Insere um valor e devolve o handle para acessá-lo
+    HandleSlot inserir(const T& valor) {
+        uint32_t indice_slot;
+        if(!livres.empty()) {
+            indice_slot = livres.back();
+            livres.pop_back();
+        } else {
+            indice_slot = static_cast<uint32_t>(slots.size());
+            slots.push_back({0, 0});
+        }
+
+        slots[indice_slot].indice_denso = static_cast<uint32_t>(densos.size());
+        densos.push_back(valor);
+        denso_para_slot.push_back(indice_slot);
+        return {indice_slot, slots[indice_slot].geracao};
+    }
+
+    // Devolve o valor do handle ou nullptr se ele já foi removido
+    T* obter(HandleSlot handle) {
+        if(handle.indice >= slots.size() || slots[handle.indice].geracao != handle.geracao) {
+            return nullptr;
+        }
+        return &densos[slots[handle.indice].indice_denso];
+    }
+
+    // Remove o valor trocando-o com o último elemento denso
+    bool remover(HandleSlot handle) {
+        if(!obter(handle)) {
+            return false;
+        }
+
+        uint32_t indice_denso = slots[handle.indice].indice_denso;
+        uint32_t ultimo = static_cast<uint32_t>(densos.size() - 1);
+        if(indice_denso != ultimo) {
+            densos[indice_denso] = densos[ultimo];
+            denso_para_slot[indice_denso] = denso_para_slot[ultimo];
+            slots[denso_para_slot[indice_denso]].indice_denso = indice_denso;
+        }
+        densos.pop_back();
+        denso_para_slot.pop_back();
+
+        slots[handle.indice].geracao++; // Invalida handles antigos deste slot
+        livres.push_back(handle.indice);
+        return true;
+    }
+
+    // Valores vivos, contíguos e em ordem arbitrária
+    const std::vector<T>& valores() const { return densos; }
+
+    size_t tamanho() const { return densos.size(); }
+    bool vazio() const { return densos.empty(); }
+
+private:
+    struct Slot {
+        uint32_t indice_denso;
+        uint32_t geracao;
+    };
+
+    std::vector<T> densos;
+    std::vector<uint32_t> denso_para_slot;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> livres;
+};
+
+#endif
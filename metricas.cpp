@@ -0,0 +1,363 @@
+#include "metricas.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+
+HistogramaLatencia::HistogramaLatencia() {
+    zerar();
+}
+
+void HistogramaLatencia::zerar() {
+    for(auto& balde : baldes) {
+        balde.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    soma.store(0, std::memory_order_relaxed);
+    menor.store(INT64_MAX, std::memory_order_relaxed);
+    maior.store(0, std::memory_order_relaxed);
+}
+
+// Valores abaixo de 2 * SUB_BALDES ficam no próprio índice; acima, o expoente
+// escolhe a faixa e os BITS_SUB bits seguintes ao mais significativo o balde
+int HistogramaLatencia::indiceBalde(int64_t valor) {
+    assert(valor >= 0);
+    if(valor < 2 * SUB_BALDES) {
+        return static_cast<int>(valor);
+    }
+    int expoente = 63 - __builtin_clzll(static_cast<uint64_t>(valor));
+    int deslocamento = expoente - BITS_SUB;
+    int sub = static_cast<int>(valor >> deslocamento);     // Entre SUB_BALDES e 2 * SUB_BALDES
+    return (deslocamento + 1) * SUB_BALDES + (sub - SUB_BALDES);
+}
+
+int64_t HistogramaLatencia::limiteSuperior(int indice) {
+    if(indice < 2 * SUB_BALDES) {
+        return indice;
+    }
+    int deslocamento = indice / SUB_BALDES - 1;
+    int64_t sub = indice % SUB_BALDES + SUB_BALDES;
+    return ((sub + 1) << deslocamento) - 1;
+}
+
+// Escritor único: carga e armazenamento relaxados bastam, sem instruções atômicas de leitura-modificação
+void HistogramaLatencia::registrar(int64_t valor) {
+    assert(valor >= 0 && "latência negativa");
+    if(valor < 0) {
+        return;
+    }
+    std::atomic<uint64_t>& balde = baldes[indiceBalde(valor)];
+    balde.store(balde.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    soma.store(soma.load(std::memory_order_relaxed) + valor, std::memory_order_relaxed);
+    if(valor < menor.load(std::memory_order_relaxed)) menor.store(valor, std::memory_order_relaxed);
+    if(valor > maior.load(std::memory_order_relaxed)) maior.store(valor, std::memory_order_relaxed);
+}
+
+void HistogramaLatencia::registrar(int64_t valor, uint64_t vezes) {
+    assert(valor >= 0 && "latência negativa");
+    if(vezes == 0 || valor < 0) {
+        return;
+    }
+    std::atomic<uint64_t>& balde = baldes[indiceBalde(valor)];
+    balde.store(balde.load(std::memory_order_relaxed) + vezes, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + vezes, std::memory_order_relaxed);
+    soma.store(soma.load(std::memory_order_relaxed) + valor * static_cast<int64_t>(vezes), std::memory_order_relaxed);
+    if(valor < menor.load(std::memory_order_relaxed)) menor.store(valor, std::memory_order_relaxed);
+    if(valor > maior.load(std::memory_order_relaxed)) maior.store(valor, std::memory_order_relaxed);
+}
+
+void HistogramaLatencia::combinar(const HistogramaLatencia& outro) {
+    for(int i = 0; i < NUM_BALDES; ++i) {
+        uint64_t n = outro.baldes[i].load(std::memory_order_relaxed);
+        if(n) {
+            baldes[i].store(baldes[i].load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+    }
+    total.store(contagem() + outro.contagem(), std::memory_order_relaxed);
+    soma.store(soma.load(std::memory_order_relaxed) + outro.soma.load(std::memory_order_relaxed),
+               std::memory_order_relaxed);
+    menor.store(std::min(menor.load(std::memory_order_relaxed), outro.menor.load(std::memory_order_relaxed)),
+                std::memory_order_relaxed);
+    maior.store(std::max(maximo(), outro.maximo()), std::memory_order_relaxed);
+}
+
+int64_t HistogramaLatencia::minimo() const {
+    return contagem() ? menor.load(std::memory_order_relaxed) : 0;
+}
+
+double HistogramaLatencia::media() const {
+    uint64_t n = contagem();
+    return n ? static_cast<double>(soma.load(std::memory_order_relaxed)) / n : 0.0;
+}
+
+int64_t HistogramaLatencia::percentil(double p) const {
+    uint64_t n = contagem();
+    if(n == 0) {
+        return 0;
+    }
+    uint64_t alvo = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * n)));
+    uint64_t acumulado = 0;
+    for(int i = 0; i < NUM_BALDES; ++i) {
+        acumulado += baldes[i].load(std::memory_order_relaxed);
+        if(acumulado >= alvo) {
+            return std::min(limiteSuperior(i), maximo());
+        }
+    }
+    return maximo();
+}
+
+const char* nomeLatencia(Latencia latencia) {
+    switch(latencia) {
+        case Latencia::ESPERA_PISTA: return "espera_pista";
+        case Latencia::OCUPACAO_PISTA: return "ocupacao_pista";
+        case Latencia::CICLO_TOTAL: return "ciclo_total";
+        case Latencia::ESPERA_TAXI: return "espera_taxi";
+        case Latencia::ESPERA_PORTAO: return "espera_portao";
+        case Latencia::ESPERA_DECOLAGEM: return "espera_decolagem";
+        default: return "desconhecida";
+    }
+}
+
+namespace {
+
+std::atomic<uint64_t> proximo_identificador{1};
+
+constexpr int NUM_LATENCIAS = static_cast<int>(Latencia::NUM_LATENCIAS);
+constexpr double PERCENTIS[] = {50.0, 90.0, 95.0, 99.0, 99.9};
+const char* const NOMES_PERCENTIS[] = {"p50_ms", "p90_ms", "p95_ms", "p99_ms", "p999_ms"};
+const char* const NOMES_PERCENTIS_US[] = {"p50_us", "p90_us", "p95_us", "p99_us", "p999_us"};
+
+// Fragmento mais recente da thread, válido enquanto o registro for o mesmo
+struct CacheFragmento {
+    uint64_t registro = 0;
+    void* fragmento = nullptr;
+};
+thread_local CacheFragmento cache_fragmento;
+
+}
+
+RegistroMetricas::RegistroMetricas()
+    : identificador(proximo_identificador.fetch_add(1)), inicio_fila_ms(-1),
+      intervalo_fila_ms(INTERVALO_FILA_MS), ultima_fila(0),
+      ticks_conflitos(0), ticks_com_violacao(0), soma_violacoes(0), soma_quase_colisoes(0), max_violacoes(0),
+      max_quase_colisoes(0), quadros_custo_us(nullptr), quadros_intervalo_us(nullptr), duracao_ms(0) {}
+
+RegistroMetricas::~RegistroMetricas() = default;
+
+// Caminho comum sem lock; na primeira vez de cada thread o fragmento é criado
+RegistroMetricas::Fragmento& RegistroMetricas::fragmentoDaThread() {
+    if(cache_fragmento.registro == identificador) {
+        return *static_cast<Fragmento*>(cache_fragmento.fragmento);
+    }
+
+    // A thread pode ter alternado entre registros: procura o fragmento dela antes de criar um
+    std::lock_guard<std::mutex> lock(mutex_fragmentos);
+    std::thread::id esta_thread = std::this_thread::get_id();
+    Fragmento* fragmento = nullptr;
+    for(const auto& existente : fragmentos) {
+        if(existente->dono == esta_thread) {
+            fragmento = existente.get();
+            break;
+        }
+    }
+    if(!fragmento) {
+        fragmentos.emplace_back(new Fragmento);
+        fragmento = fragmentos.back().get();
+        fragmento->dono = esta_thread;
+    }
+    cache_fragmento.registro = identificador;
+    cache_fragmento.fragmento = fragmento;
+    return *fragmento;
+}
+
+void RegistroMetricas::registrar(Latencia latencia, int64_t valor_ms) {
+    fragmentoDaThread().histogramas[static_cast<int>(latencia)].registrar(valor_ms);
+}
+
+void RegistroMetricas::amostrarFila(int64_t agora_ms, size_t profundidade) {
+    if(inicio_fila_ms < 0) {
+        inicio_fila_ms = agora_ms;
+    }
+    size_t intervalo = static_cast<size_t>((agora_ms - inicio_fila_ms) / intervalo_fila_ms);
+    while(intervalo >= MAX_INTERVALOS_FILA) {
+        compactarFila();
+        intervalo = static_cast<size_t>((agora_ms - inicio_fila_ms) / intervalo_fila_ms);
+    }
+    // Intervalos sem amostra mantêm a última profundidade vista (a fila não mudou neles)
+    if(intervalo >= fila_maxima.size()) {
+        fila_maxima.resize(intervalo + 1, ultima_fila);
+        fila_maxima[intervalo] = 0;
+    }
+    ultima_fila = static_cast<uint32_t>(profundidade);
+    fila_maxima[intervalo] = std::max(fila_maxima[intervalo], ultima_fila);
+}
+
+// Junta os intervalos dois a dois (o máximo do par) e dobra a largura
+void RegistroMetricas::compactarFila() {
+    size_t metade = (fila_maxima.size() + 1) / 2;
+    for(size_t i = 0; i < metade; ++i) {
+        uint32_t maximo = fila_maxima[2 * i];
+        if(2 * i + 1 < fila_maxima.size()) {
+            maximo = std::max(maximo, fila_maxima[2 * i + 1]);
+        }
+        fila_maxima[i] = maximo;
+    }
+    fila_maxima.resize(metade);
+    intervalo_fila_ms *= 2;
+}
+
+void RegistroMetricas::registrarConflitos(uint64_t violacoes, uint64_t quase_colisoes) {
+    ticks_conflitos++;
+    ticks_com_violacao += violacoes > 0;
+    soma_violacoes += violacoes;
+    soma_quase_colisoes += quase_colisoes;
+    max_violacoes = std::max(max_violacoes, violacoes);
+    max_quase_colisoes = std::max(max_quase_colisoes, quase_colisoes);
+}
+
+void RegistroMetricas::registrarContencao(const std::string& nome, const ContadorContencao* contador) {
+    contencoes.emplace_back(nome, contador);
+}
+
+void RegistroMetricas::registrarQuadros(const HistogramaLatencia* custo_us, const HistogramaLatencia* intervalo_us) {
+    quadros_custo_us = custo_us;
+    quadros_intervalo_us = intervalo_us;
+}
+
+void RegistroMetricas::definirUsoPistas(const std::vector<int64_t>& uso_ms, int64_t duracao) {
+    uso_pistas_ms = uso_ms;
+    duracao_ms = duracao;
+}
+
+void RegistroMetricas::combinar(Latencia latencia, HistogramaLatencia& destino) const {
+    std::lock_guard<std::mutex> lock(mutex_fragmentos);
+    for(const auto& fragmento : fragmentos) {
+        destino.combinar(fragmento->histogramas[static_cast<int>(latencia)]);
+    }
+}
+
+bool RegistroMetricas::salvar(const std::string& caminho) const {
+    std::ofstream arquivo(caminho);
+    if(!arquivo) {
+        return false;
+    }
+    bool csv = caminho.size() >= 4 && caminho.compare(caminho.size() - 4, 4, ".csv") == 0;
+    if(csv) {
+        exportarCsv(arquivo);
+    } else {
+        exportarJson(arquivo);
+    }
+    return static_cast<bool>(arquivo);
+}
+
+void RegistroMetricas::exportarJson(std::ostream& saida) const {
+    saida << "{\n  \"latencias\": {";
+    for(int l = 0; l < NUM_LATENCIAS; ++l) {
+        HistogramaLatencia histograma;
+        combinar(static_cast<Latencia>(l), histograma);
+        saida << (l ? "," : "") << "\n    \"" << nomeLatencia(static_cast<Latencia>(l)) << "\": {"
+              << "\"contagem\": " << histograma.contagem()
+              << ", \"media_ms\": " << histograma.media()
+              << ", \"minimo_ms\": " << histograma.minimo();
+        for(size_t p = 0; p < sizeof(PERCENTIS) / sizeof(PERCENTIS[0]); ++p) {
+            saida << ", \"" << NOMES_PERCENTIS[p] << "\": " << histograma.percentil(PERCENTIS[p]);
+        }
+        saida << ", \"maximo_ms\": " << histograma.maximo() << "}";
+    }
+
+    saida << "\n  },\n  \"duracao_ms\": " << duracao_ms << ",\n  \"pistas\": [";
+    for(size_t i = 0; i < uso_pistas_ms.size(); ++i) {
+        double fracao = duracao_ms > 0 ? static_cast<double>(uso_pistas_ms[i]) / duracao_ms : 0.0;
+        saida << (i ? "," : "") << "\n    {\"pista\": " << i + 1 << ", \"uso_ms\": " << uso_pistas_ms[i]
+              << ", \"fracao_ocupada\": " << fracao << "}";
+    }
+
+    saida << "\n  ],\n  \"fila\": {\"intervalo_ms\": " << intervalo_fila_ms << ", \"maximo_por_intervalo\": [";
+    for(size_t i = 0; i < fila_maxima.size(); ++i) {
+        saida << (i ? ", " : "") << fila_maxima[i];
+    }
+
+    saida << "]},\n  \"conflitos\": {\"ticks\": " << ticks_conflitos << ", \"ticks_com_violacao\": " << ticks_com_violacao
+          << ", \"violacoes\": " << soma_violacoes << ", \"quase_colisoes\": " << soma_quase_colisoes
+          << ", \"max_violacoes_por_tick\": " << max_violacoes
+          << ", \"max_quase_colisoes_por_tick\": " << max_quase_colisoes << "},\n  \"quadros\": {";
+    const std::pair<const char*, const HistogramaLatencia*> quadros[] = {{"custo", quadros_custo_us},
+                                                                          {"intervalo", quadros_intervalo_us}};
+    bool primeiro = true;
+    for(const auto& quadro : quadros) {
+        if(!quadro.second) {
+            continue;
+        }
+        const HistogramaLatencia& histograma = *quadro.second;
+        saida << (primeiro ? "" : ",") << "\n    \"" << quadro.first << "\": {\"contagem\": " << histograma.contagem()
+              << ", \"media_us\": " << histograma.media() << ", \"minimo_us\": " << histograma.minimo();
+        for(size_t p = 0; p < sizeof(PERCENTIS) / sizeof(PERCENTIS[0]); ++p) {
+            saida << ", \"" << NOMES_PERCENTIS_US[p] << "\": " << histograma.percentil(PERCENTIS[p]);
+        }
+        saida << ", \"maximo_us\": " << histograma.maximo() << "}";
+        primeiro = false;
+    }
+    saida << (primeiro ? "" : "\n  ") << "},\n  \"contencao\": {";
+    for(size_t i = 0; i < contencoes.size(); ++i) {
+        const ContadorContencao& contador = *contencoes[i].second;
+        saida << (i ? "," : "") << "\n    \"" << contencoes[i].first << "\": {"
+              << "\"aquisicoes\": " << contador.aquisicoes.load()
+              << ", \"contendidas\": " << contador.contendidas.load()
+              << ", \"espera_ms\": " << contador.espera_ns.load() / 1e6 << "}";
+    }
+    saida << "\n  }\n}\n";
+}
+
+// Formato longo (secao,nome,campo,valor), fácil de filtrar em planilhas e scripts
+void RegistroMetricas::exportarCsv(std::ostream& saida) const {
+    saida << "secao,nome,campo,valor\n";
+    for(int l = 0; l < NUM_LATENCIAS; ++l) {
+        HistogramaLatencia histograma;
+        combinar(static_cast<Latencia>(l), histograma);
+        const char* nome = nomeLatencia(static_cast<Latencia>(l));
+        saida << "latencia," << nome << ",contagem," << histograma.contagem() << "\n"
+              << "latencia," << nome << ",media_ms," << histograma.media() << "\n"
+              << "latencia," << nome << ",minimo_ms," << histograma.minimo() << "\n";
+        for(size_t p = 0; p < sizeof(PERCENTIS) / sizeof(PERCENTIS[0]); ++p) {
+            saida << "latencia," << nome << "," << NOMES_PERCENTIS[p] << "," << histograma.percentil(PERCENTIS[p]) << "\n";
+        }
+        saida << "latencia," << nome << ",maximo_ms," << histograma.maximo() << "\n";
+    }
+
+    saida << "execucao,total,duracao_ms," << duracao_ms << "\n";
+    for(size_t i = 0; i < uso_pistas_ms.size(); ++i) {
+        double fracao = duracao_ms > 0 ? static_cast<double>(uso_pistas_ms[i]) / duracao_ms : 0.0;
+        saida << "pista," << i + 1 << ",uso_ms," << uso_pistas_ms[i] << "\n"
+              << "pista," << i + 1 << ",fracao_ocupada," << fracao << "\n";
+    }
+    for(size_t i = 0; i < fila_maxima.size(); ++i) {
+        saida << "fila," << i * intervalo_fila_ms << ",maximo," << fila_maxima[i] << "\n";
+    }
+    saida << "conflitos,total,ticks," << ticks_conflitos << "\n"
+          << "conflitos,total,ticks_com_violacao," << ticks_com_violacao << "\n"
+          << "conflitos,total,violacoes," << soma_violacoes << "\n"
+          << "conflitos,total,quase_colisoes," << soma_quase_colisoes << "\n"
+          << "conflitos,total,max_violacoes_por_tick," << max_violacoes << "\n"
+          << "conflitos,total,max_quase_colisoes_por_tick," << max_quase_colisoes << "\n";
+    const std::pair<const char*, const HistogramaLatencia*> quadros[] = {{"custo", quadros_custo_us},
+                                                                          {"intervalo", quadros_intervalo_us}};
+    for(const auto& quadro : quadros) {
+        if(!quadro.second) {
+            continue;
+        }
+        const HistogramaLatencia& histograma = *quadro.second;
+        saida << "quadros," << quadro.first << ",contagem," << histograma.contagem() << "\n"
+              << "quadros," << quadro.first << ",media_us," << histograma.media() << "\n"
+              << "quadros," << quadro.first << ",minimo_us," << histograma.minimo() << "\n";
+        for(size_t p = 0; p < sizeof(PERCENTIS) / sizeof(PERCENTIS[0]); ++p) {
+            saida << "quadros," << quadro.first << "," << NOMES_PERCENTIS_US[p] << "," << histograma.percentil(PERCENTIS[p]) << "\n";
+        }
+        saida << "quadros," << quadro.first << ",maximo_us," << histograma.maximo() << "\n";
+    }
+    for(const auto& contencao : contencoes) {
+        saida << "contencao," << contencao.first << ",aquisicoes," << contencao.second->aquisicoes.load() << "\n"
+              << "contencao," << contencao.first << ",contendidas," << contencao.second->contendidas.load() << "\n"
+              << "contencao," << contencao.first << ",espera_ms," << contencao.second->espera_ns.load() / 1e6 << "\n";
+    }
+}
@@ -0,0 +1,154 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "contencao.h"
+
+// Histograma log-linear no estilo HDR: valores abaixo de 2^(BITS_SUB+1) são
+// exatos e, acima disso, cada potência de dois é dividida em 2^BITS_SUB baldes (erro
+// relativo abaixo de 2^-BITS_SUB, ~3%). Registrar é um índice e um incremento.
+// Cada histograma tem um único escritor; a leitura de outra thread vê os
+// contadores atômicos sem travar o escritor.
+class HistogramaLatencia {
+public:
+    static constexpr int BITS_SUB = 5;
+    static constexpr int SUB_BALDES = 1 << BITS_SUB;
+    static constexpr int NUM_BALDES = (64 - BITS_SUB) * SUB_BALDES;
+
+    HistogramaLatencia();
+
+    // Somente a thread dona do histograma registra. Latência negativa é erro
+    // de quem mede: dispara o assert e, compilado com NDEBUG, é descartada
+    void registrar(int64_t valor);
+
+    // Registra o mesmo valor `vezes` vezes de uma só vez
+    void registrar(int64_t valor, uint64_t vezes);
+
+    // Soma os contadores de outro histograma neste (usado na leitura)
+    void combinar(const HistogramaLatencia& outro);
+
+    // Volta ao histograma vazio (pelo dono, sem leitores em andamento)
+    void zerar();
+
+    uint64_t contagem() const { return total.load(std::memory_order_relaxed); }
+    int64_t minimo() const;
+    int64_t maximo() const { return maior.load(std::memory_order_relaxed); }
+    double media() const;
+
+    // Valor do percentil p (0 a 100), arredondado para o limite superior do balde
+    int64_t percentil(double p) const;
+
+    static int indiceBalde(int64_t valor);
+    static int64_t limiteSuperior(int indice);
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BALDES> baldes;
+    std::atomic<uint64_t> total;
+    std::atomic<int64_t> soma;
+    std::atomic<int64_t> menor;
+    std::atomic<int64_t> maior;
+};
+
+// Latências registradas por avião
+enum class Latencia {
+    ESPERA_PISTA,       // Do pedido de pouso até a pista ser concedida
+    OCUPACAO_PISTA,     // Da concessão até a liberação da pista
+    CICLO_TOTAL,        // Da entrada no céu até a liberação da pista
+    ESPERA_TAXI,        // Do pedido até receber uma via de táxi (só com portões e vias limitadas)
+    ESPERA_PORTAO,      // Do fim do táxi de entrada até receber um portão
+    ESPERA_DECOLAGEM,   // Do fim do táxi de saída até receber a pista para decolar
+    NUM_LATENCIAS
+};
+
+const char* nomeLatencia(Latencia latencia);
+
+// Registro central de métricas de uma execução. As latências vão para
+// histogramas por thread, criados no primeiro registro de cada thread e
+// somados só na leitura, então registrar não trava nem compartilha linhas de
+// cache entre threads. Profundidade de fila, ocupação das pistas, conflitos
+// entre aviões em voo, contenção dos locks e, na janela, o tempo dos quadros
+// completam o relatório exportado em JSON ou CSV.
+class RegistroMetricas {
+public:
+    // Intervalo inicial das amostras da fila de espera. A série guarda no
+    // máximo MAX_INTERVALOS_FILA intervalos: ao encher, junta os vizinhos dois a
+    // dois e dobra o intervalo, então não cresce com a duração da execução.
+    static constexpr int64_t INTERVALO_FILA_MS = 1000;
+    static constexpr size_t MAX_INTERVALOS_FILA = 4096;
+
+    RegistroMetricas();
+    ~RegistroMetricas();
+
+    RegistroMetricas(const RegistroMetricas&) = delete;
+    RegistroMetricas& operator=(const RegistroMetricas&) = delete;
+
+    // Registra uma latência em milissegundos no histograma da thread atual
+    void registrar(Latencia latencia, int64_t valor_ms);
+
+    // Amostra a profundidade da fila de pistas; guarda o máximo de cada intervalo.
+    // Chamada sempre pela mesma thread (o tick na versão gráfica, o laço de eventos na headless)
+    void amostrarFila(int64_t agora_ms, size_t profundidade);
+
+    // Conflitos entre aviões em voo contados em um tick (chamada só pelo tick)
+    void registrarConflitos(uint64_t violacoes, uint64_t quase_colisoes);
+
+    // Contadores de contenção lidos na exportação; devem viver até lá
+    void registrarContencao(const std::string& nome, const ContadorContencao* contador);
+
+    // Histogramas dos quadros da janela (custo e intervalo, em µs), lidos na exportação
+    void registrarQuadros(const HistogramaLatencia* custo_us, const HistogramaLatencia* intervalo_us);
+
+    // Uso acumulado de cada pista e duração da execução, informados ao final
+    void definirUsoPistas(const std::vector<int64_t>& uso_ms, int64_t duracao_ms);
+
+    // Soma dos histogramas de todas as threads
+    void combinar(Latencia latencia, HistogramaLatencia& destino) const;
+
+    // Exporta tudo; o formato é escolhido pela extensão (.csv ou JSON nos demais casos)
+    bool salvar(const std::string& caminho) const;
+    void exportarJson(std::ostream& saida) const;
+    void exportarCsv(std::ostream& saida) const;
+
+private:
+    struct Fragmento {
+        std::thread::id dono;
+        HistogramaLatencia histogramas[static_cast<int>(Latencia::NUM_LATENCIAS)];
+    };
+
+    Fragmento& fragmentoDaThread();
+    void compactarFila();
+
+    const uint64_t identificador;       // Distingue registros que reaproveitam o mesmo endereço
+    mutable std::mutex mutex_fragmentos; // Só na criação de fragmentos e na leitura
+    std::vector<std::unique_ptr<Fragmento>> fragmentos;
+
+    int64_t inicio_fila_ms;
+    int64_t intervalo_fila_ms;          // INTERVALO_FILA_MS, dobrado a cada compactação
+    uint32_t ultima_fila;
+    std::vector<uint32_t> fila_maxima;  // Máximo da fila em cada intervalo
+
+    // Conflitos somados sobre os ticks (um par em conflito por 10 ticks conta 10)
+    uint64_t ticks_conflitos;
+    uint64_t ticks_com_violacao;
+    uint64_t soma_violacoes;
+    uint64_t soma_quase_colisoes;
+    uint64_t max_violacoes;
+    uint64_t max_quase_colisoes;
+
+    std::vector<std::pair<std::string, const ContadorContencao*>> contencoes;
+    const HistogramaLatencia* quadros_custo_us;
+    const HistogramaLatencia* quadros_intervalo_us;
+    std::vector<int64_t> uso_pistas_ms;
+    int64_t duracao_ms;
+};
+
+#endif
@@ -8,10 +8,10 @@
 struct Runway {
     int id;                 // Identificador da pista
     SDL_Rect rect;          // Posição e tamanho da pista
-    bool occupied;          // Status de ocupação
+                            // A ocupação fica no AlocadorRecursos das pistas
 
     Runway(int runway_id, SDL_Rect runway_rect)
-        : id(runway_id), rect(runway_rect), occupied(false) {}
+        : id(runway_id), rect(runway_rect) {}
 };
 
 #endif // PISTA_H
@@ -0,0 +1,125 @@
+#include "politicas.h"
+
+int PoliticaEscalonamento::reservarRecurso(MapaBitsAtomico& ocupados, const std::vector<std::atomic<int64_t>>&) const {
+    return ocupados.reservarPrimeiroLivre();
+}
+
+namespace {
+
+// Ordem de chegada
+class PoliticaFifo : public PoliticaEscalonamento {
+public:
+    const char* nome() const override { return "fifo"; }
+    void enfileirar(const Solicitacao& solicitacao) override { fila.push_back(solicitacao); }
+    Solicitacao retirar() override {
+        Solicitacao primeira = fila.front();
+        fila.pop_front();
+        return primeira;
+    }
+    bool vazia() const override { return fila.empty(); }
+    size_t tamanho() const override { return fila.size(); }
+
+private:
+    std::deque<Solicitacao> fila;
+};
+
+// Fila ordenada por um critério, com desempate pela ordem de chegada
+template<typename Antes>
+class PoliticaOrdenada : public PoliticaEscalonamento {
+public:
+    explicit PoliticaOrdenada(const char* nome_politica) : nome_politica(nome_politica) {}
+
+    const char* nome() const override { return nome_politica; }
+    void enfileirar(const Solicitacao& solicitacao) override { fila.push(solicitacao); }
+    Solicitacao retirar() override {
+        Solicitacao primeira = fila.top();
+        fila.pop();
+        return primeira;
+    }
+    bool vazia() const override { return fila.empty(); }
+    size_t tamanho() const override { return fila.size(); }
+
+private:
+    // priority_queue devolve o maior; "depois" é o comparador invertido
+    struct Depois {
+        bool operator()(const Solicitacao& a, const Solicitacao& b) const { return Antes()(b, a); }
+    };
+
+    const char* nome_politica;
+    std::priority_queue<Solicitacao, std::vector<Solicitacao>, Depois> fila;
+};
+
+struct MenorServicoAntes {
+    bool operator()(const Solicitacao& a, const Solicitacao& b) const {
+        if(a.servico_ms != b.servico_ms) return a.servico_ms < b.servico_ms;
+        return a.sequencia < b.sequencia;
+    }
+};
+
+struct PrioridadeAntes {
+    bool operator()(const Solicitacao& a, const Solicitacao& b) const {
+        if(a.prioridade != b.prioridade) return a.prioridade > b.prioridade;
+        return a.sequencia < b.sequencia;
+    }
+};
+
+// Ordem de chegada, entregando a pista livre com menos tempo de uso acumulado
+class PoliticaBalanceamento : public PoliticaFifo {
+public:
+    const char* nome() const override { return "balanceamento"; }
+    int reservarRecurso(MapaBitsAtomico& ocupados, const std::vector<std::atomic<int64_t>>& uso_ms) const override {
+        // Escolhe entre os livres vistos agora; se outro pedido levar o escolhido antes do CAS, tenta de novo
+        while(true) {
+            int escolhido = -1;
+            int64_t menor_uso = 0;
+            for(size_t p = 0; p < ocupados.numPalavras(); ++p) {
+                for(uint64_t livres = ~ocupados.palavra(p); livres; livres &= livres - 1) {
+                    size_t i = p * 64 + __builtin_ctzll(livres);
+                    int64_t uso = uso_ms[i].load(std::memory_order_relaxed);
+                    if(escolhido == -1 || uso < menor_uso) {
+                        escolhido = static_cast<int>(i);
+                        menor_uso = uso;
+                    }
+                }
+            }
+            if(escolhido == -1 || ocupados.reservar(escolhido)) {
+                return escolhido;
+            }
+        }
+    }
+};
+
+} // namespace
+
+std::unique_ptr<PoliticaEscalonamento> criarPolitica(TipoPolitica tipo) {
+    switch(tipo) {
+        case TipoPolitica::MENOR_SERVICO:
+            return std::unique_ptr<PoliticaEscalonamento>(new PoliticaOrdenada<MenorServicoAntes>("menor-servico"));
+        case TipoPolitica::PRIORIDADE:
+            return std::unique_ptr<PoliticaEscalonamento>(new PoliticaOrdenada<PrioridadeAntes>("prioridade"));
+        case TipoPolitica::BALANCEAMENTO:
+            return std::unique_ptr<PoliticaEscalonamento>(new PoliticaBalanceamento());
+        case TipoPolitica::FIFO:
+        default:
+            return std::unique_ptr<PoliticaEscalonamento>(new PoliticaFifo());
+    }
+}
+
+bool politicaPorNome(const std::string& nome, TipoPolitica& tipo) {
+    if(nome == "fifo") tipo = TipoPolitica::FIFO;
+    else if(nome == "menor-servico") tipo = TipoPolitica::MENOR_SERVICO;
+    else if(nome == "prioridade") tipo = TipoPolitica::PRIORIDADE;
+    else if(nome == "balanceamento") tipo = TipoPolitica::BALANCEAMENTO;
+    else return false;
+    return true;
+}
+
+const char* nomePolitica(TipoPolitica tipo) {
+    switch(tipo) {
+        case TipoPolitica::MENOR_SERVICO: return "menor-servico";
+        case TipoPolitica::PRIORIDADE: return "prioridade";
+        case TipoPolitica::BALANCEAMENTO: return "balanceamento";
+        case TipoPolitica::FIFO:
+        default: return "fifo";
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef POLITICAS_H
+#define POLITICAS_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+#include "mapa_bits.h"
+
+// Pedido de um recurso (pista) guardado na fila do alocador
+struct Solicitacao {
+    void* solicitante = nullptr;
+    int64_t chegada_ms = 0;     // Instante do pedido
+    int64_t servico_ms = 0;     // Tempo estimado de uso do recurso
+    int prioridade = 0;         // Maior é mais urgente (ex: emergência)
+    uint64_t sequencia = 0;     // Ordem de chegada, preenchida pelo alocador
+};
+
+// Políticas de escalonamento disponíveis
+enum class TipoPolitica {
+    FIFO,           // Ordem de chegada
+    MENOR_SERVICO,  // Menor tempo de serviço primeiro
+    PRIORIDADE,     // Emergências primeiro, ordem de chegada dentro da mesma prioridade
+    BALANCEAMENTO   // Ordem de chegada, escolhendo a pista livre menos usada
+};
+
+// Política de escalonamento: decide quem da fila recebe o próximo recurso
+// liberado e qual recurso livre entregar a um novo pedido.
+class PoliticaEscalonamento {
+public:
+    virtual ~PoliticaEscalonamento() = default;
+
+    virtual const char* nome() const = 0;
+    virtual void enfileirar(const Solicitacao& solicitacao) = 0;
+    virtual Solicitacao retirar() = 0;
+    virtual bool vazia() const = 0;
+    virtual size_t tamanho() const = 0;
+
+    // Reserva um recurso livre no mapa e devolve o índice, ou -1 se nenhum está livre
+    // (padrão: o primeiro livre). Chamada sem lock, de qualquer thread.
+    virtual int reservarRecurso(MapaBitsAtomico& ocupados, const std::vector<std::atomic<int64_t>>& uso_ms) const;
+};
+
+// Cria a política pedida
+std::unique_ptr<PoliticaEscalonamento> criarPolitica(TipoPolitica tipo);
+
+// Converte entre o nome usado na linha de comando e o tipo da política
+bool politicaPorNome(const std::string& nome, TipoPolitica& tipo);
+const char* nomePolitica(TipoPolitica tipo);
+
+#endif
@@ -0,0 +1,161 @@
+#include "pool_tarefas.h"
+#include <algorithm>
+
+namespace {
+
+// Passo em execução na thread atual (pool e prazo da tarefa)
+thread_local const PoolTarefas* pool_do_passo = nullptr;
+thread_local int64_t prazo_do_passo = 0;
+
+} // namespace
+
+PoolTarefas::PoolTarefas(RelogioSimulacao& relogio, unsigned num_threads)
+    : relogio_simulacao(relogio), proxima_sequencia(0), ativas(0), executando(0), prazo_executando(0),
+      cancelando(false), parando(false) {
+    // Mudou a escala: o instante real de cada prazo mudou junto
+    observador_relogio = relogio_simulacao.observar([this] {
+        std::lock_guard<std::mutex> lock(mutex);
+        cond.notify_all();
+    });
+    if(num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads.reserve(num_threads);
+    for(unsigned i = 0; i < num_threads; ++i) {
+        threads.emplace_back(&PoolTarefas::loopThread, this);
+    }
+}
+
+PoolTarefas::~PoolTarefas() {
+    relogio_simulacao.deixarDeObservar(observador_relogio);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        parando = true;
+    }
+    cond.notify_all();
+    for(auto& thread : threads) {
+        thread.join();
+    }
+
+    // Descarta as tarefas que não chegaram a concluir
+    while(!agenda.empty()) {
+        agenda.top().tarefa->liberar();
+        agenda.pop();
+    }
+}
+
+// Entrega uma nova tarefa ao pool
+void PoolTarefas::agendar(TarefaPool* tarefa, int64_t atraso_ms) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ativas++;
+    }
+    inserir(tarefa, instanteAtual() + atraso_ms);
+}
+
+// Retoma uma tarefa que estava suspensa, no mínimo no prazo em que ela parou
+void PoolTarefas::retomar(TarefaPool* tarefa) {
+    inserir(tarefa, std::max(instanteAtual(), tarefa->prazo_ms));
+}
+
+// Coloca a tarefa no heap de prazos e acorda uma thread para reavaliar o próximo prazo
+void PoolTarefas::inserir(TarefaPool* tarefa, int64_t prazo_ms) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        agenda.push({prazo_ms, proxima_sequencia++, tarefa});
+    }
+    cond.notify_one();
+}
+
+// Espera os passos em andamento sem começar outros e esvazia a agenda: as
+// tarefas que um passo reagendou ou retomou nesse meio-tempo vão junto
+size_t PoolTarefas::cancelar() {
+    std::vector<TarefaPool*> descartadas;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cancelando = true;
+        cond_ocioso.wait(lock, [this] { return executando == 0; });
+        while(!agenda.empty()) {
+            descartadas.push_back(agenda.top().tarefa);
+            agenda.pop();
+        }
+        ativas -= descartadas.size();
+        cancelando = false;
+    }
+    for(TarefaPool* tarefa : descartadas) {
+        tarefa->liberar();
+    }
+    return descartadas.size();
+}
+
+// Tarefa estacionada fora do pool que não será mais retomada
+void PoolTarefas::descartar(TarefaPool* tarefa) {
+    tarefa->liberar();
+    std::lock_guard<std::mutex> lock(mutex);
+    ativas--;
+}
+
+int64_t PoolTarefas::instanteAtual() const {
+    return pool_do_passo == this ? prazo_do_passo : relogio_simulacao.agoraMs();
+}
+
+size_t PoolTarefas::tarefasAtivas() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return ativas;
+}
+
+// Loop de cada thread: espera o prazo mais próximo, executa um passo e reagenda
+void PoolTarefas::loopThread() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while(!parando) {
+        if(agenda.empty() || cancelando) {
+            cond.wait(lock);
+            continue;
+        }
+
+        int64_t prazo = agenda.top().prazo;
+        if(prazo > relogio_simulacao.agoraMs()) {
+            cond.wait_until(lock, relogio_simulacao.instanteReal(prazo));
+            continue;
+        }
+
+        // Passos vencidos rodam em ordem de prazo: só os do mesmo instante
+        // correm juntos. Quem termina o último passo em andamento volta ao
+        // laço e assume o próximo prazo.
+        if(executando > 0 && prazo != prazo_executando) {
+            cond.wait(lock);
+            continue;
+        }
+
+        TarefaPool* tarefa = agenda.top().tarefa;
+        agenda.pop();
+
+        // Ainda há trabalho vencido: outra thread pode assumir o próximo
+        if(!agenda.empty()) {
+            cond.notify_one();
+        }
+
+        executando++;
+        prazo_executando = prazo;
+        lock.unlock();
+        pool_do_passo = this;
+        prazo_do_passo = prazo;
+        tarefa->prazo_ms = prazo;
+        int64_t atraso_ms = tarefa->executar();
+        if(atraso_ms == TAREFA_CONCLUIDA) {
+            tarefa->liberar();
+            lock.lock();
+            ativas--;
+        } else if(atraso_ms == TAREFA_SUSPENSA) {
+            // Quem guardou a tarefa é responsável por chamar retomar()
+            lock.lock();
+        } else {
+            inserir(tarefa, prazo + atraso_ms);
+            lock.lock();
+        }
+        pool_do_passo = nullptr;
+        if(--executando == 0 && cancelando) {
+            cond_ocioso.notify_all();
+        }
+    }
+}
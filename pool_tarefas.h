@@ -0,0 +1,115 @@
+#ifndef POOL_TAREFAS_H
+#define POOL_TAREFAS_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "relogio.h"
+
+// Valor devolvido por TarefaPool::executar() quando a tarefa terminou
+constexpr int64_t TAREFA_CONCLUIDA = -1;
+
+// Valor devolvido quando a tarefa ficou estacionada esperando um recurso; quem
+// entregar o recurso chama PoolTarefas::retomar(). Depois de se estacionar, a
+// tarefa não pode mais tocar no próprio estado nesse passo.
+constexpr int64_t TAREFA_SUSPENSA = -2;
+
+// Tarefa retomável executada pelo pool. Cada chamada a executar() roda um passo
+// curto e devolve em quantos milissegundos (virtuais, do relógio da simulação)
+// a tarefa deve ser executada de novo.
+class TarefaPool {
+public:
+    virtual ~TarefaPool() = default;
+    virtual int64_t executar() = 0;
+
+    // Chamada pelo pool quando a tarefa conclui ou é descartada. Tarefas
+    // criadas em uma arena a sobrescrevem para voltar a ela.
+    virtual void liberar() { delete this; }
+
+private:
+    friend class PoolTarefas;
+    int64_t prazo_ms = 0;   // Prazo do último passo executado; a retomada não volta antes dele
+};
+
+// Pool fixo de threads (uma por núcleo) com um temporizador compartilhado.
+// As esperas das tarefas viram prazos em um heap, então nenhuma thread fica
+// bloqueada em sleep e o número de threads não depende do número de tarefas.
+// Os prazos são instantes do relógio da simulação; quando a escala muda, as
+// threads que esperam são acordadas para converter o prazo de novo em tempo real.
+// Passos vencidos rodam em ordem de prazo: só os do mesmo instante correm em
+// paralelo, então um passo atrasado não é ultrapassado pelos seguintes.
+class PoolTarefas {
+public:
+    explicit PoolTarefas(RelogioSimulacao& relogio, unsigned num_threads = 0); // 0: uma thread por núcleo
+    ~PoolTarefas();
+
+    PoolTarefas(const PoolTarefas&) = delete;
+    PoolTarefas& operator=(const PoolTarefas&) = delete;
+
+    // Entrega uma nova tarefa ao pool, que passa a ser dono dela e a libera ao concluir
+    void agendar(TarefaPool* tarefa, int64_t atraso_ms);
+
+    // Recoloca uma tarefa suspensa na agenda para ser executada imediatamente:
+    // no instante de quem a retoma, mas nunca antes do passo em que ela se
+    // estacionou. Com várias threads, passos vencidos rodam fora da ordem dos
+    // prazos, e sem esse piso o tempo da tarefa retomada andaria para trás.
+    void retomar(TarefaPool* tarefa);
+
+    // Sinal de parada: interrompe todas as esperas de uma vez, descartando as
+    // tarefas agendadas (e as reagendadas ou retomadas durante o cancelamento),
+    // e volta assim que nenhum passo está em andamento, sem esperar prazo
+    // nenhum. As threads continuam disponíveis para a próxima execução. Chamar
+    // fora das threads do pool; devolve quantas tarefas foram descartadas.
+    size_t cancelar();
+
+    // Destrói uma tarefa suspensa que não será mais retomada (depois de cancelar())
+    void descartar(TarefaPool* tarefa);
+
+    // Número de tarefas entregues ao pool que ainda não concluíram (inclui as suspensas)
+    size_t tarefasAtivas() const;
+
+    size_t numThreads() const { return threads.size(); }
+
+    // Instante virtual (ms) do passo em execução nesta thread: o prazo da tarefa,
+    // não o momento em que uma thread chegou a ela. Os atrasos devolvidos e as
+    // retomadas contam a partir dele, então um passo executado com atraso não
+    // empurra os seguintes e o resultado não depende da escala nem da carga da
+    // máquina. Fora de um passo do pool, é o instante atual do relógio.
+    int64_t instanteAtual() const;
+
+    const RelogioSimulacao& relogio() const { return relogio_simulacao; }
+
+private:
+    struct Agendamento {
+        int64_t prazo;          // Instante virtual (ms)
+        uint64_t sequencia;
+        TarefaPool* tarefa;
+
+        bool operator>(const Agendamento& outro) const {
+            if(prazo != outro.prazo) return prazo > outro.prazo;
+            return sequencia > outro.sequencia;
+        }
+    };
+
+    void inserir(TarefaPool* tarefa, int64_t prazo_ms);
+    void loopThread();
+
+    RelogioSimulacao& relogio_simulacao;
+    int observador_relogio;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::condition_variable cond_ocioso;    // Acordada quando o último passo em andamento termina
+    std::priority_queue<Agendamento, std::vector<Agendamento>, std::greater<Agendamento>> agenda;
+    uint64_t proxima_sequencia;
+    size_t ativas;
+    size_t executando;      // Passos em andamento
+    int64_t prazo_executando;   // Prazo comum a todos os passos em andamento
+    bool cancelando;        // Nenhum passo novo começa enquanto cancelar() espera
+    bool parando;
+    std::vector<std::thread> threads;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "quadro.h"
+#include "gravacao.h"
+#include <algorithm>
+#include <cmath>
+
+TickSimulacao::TickSimulacao(RegistroAvioes& avioes, FrotaAerea& frota, std::mutex& mutex_avioes,
+                             ContadorContencao& contencao, const AlocadorRecursos& alocador_pistas,
+                             BufferTriplo<QuadroSimulacao>& quadros, RegistroMetricas& metricas,
+                             const PoolTarefas& pool, GravadorSimulacao& gravacao)
+    : avioes(avioes), frota(frota), mutex_avioes(mutex_avioes), contencao(contencao),
+      alocador_pistas(alocador_pistas), quadros(quadros), metricas(metricas), pool(pool), gravacao(gravacao),
+      proximo_numero(1),
+      ultimo_passo_ms(-1) {}
+
+// Avança a frota, copia o estado para o buffer de escrita e o publica (~60 vezes por segundo)
+int64_t TickSimulacao::executar() {
+    // Instante atual do relógio, não o prazo do passo: o tick acompanha a tela
+    int64_t agora_ms = pool.relogio().agoraMs();
+    int64_t passos = 1;
+    if(ultimo_passo_ms < 0) {
+        ultimo_passo_ms = agora_ms;
+    } else {
+        passos = (agora_ms - ultimo_passo_ms) / ATRASO_MOVIMENTO_MS;
+        ultimo_passo_ms += passos * ATRASO_MOVIMENTO_MS;
+    }
+
+    QuadroSimulacao& quadro = quadros.escrita();
+    {
+        TravaMedida lock(mutex_avioes, contencao);
+        // Todos os passos vencidos de uma vez, em tempo que não depende de quantos são
+        if(passos > 0) {
+            frota.avancar(passos);
+        }
+
+        // Devolve as posições ao registro, que é a fonte do quadro publicado
+        for(size_t i = 0; i < frota.tamanho(); ++i) {
+            if(Plane* p = avioes.obter(frota.handle(i))) {
+                p->x = frota.posicaoX(i);
+                p->movendoParaDireita = frota.movendoParaDireita(i);
+            }
+        }
+
+        // assign reaproveita a capacidade do buffer, sem alocar em regime
+        quadro.avioes.assign(avioes.valores().begin(), avioes.valores().end());
+
+        // Só a cópia das posições para a grade precisa dos arrays estáveis
+        grade_conflitos.construir(frota.dadosX(), frota.dadosY(), frota.tamanho());
+    }
+    quadro.conflitos = grade_conflitos.detectar();
+    metricas.registrarConflitos(quadro.conflitos.violacoes, quadro.conflitos.quase_colisoes);
+    alocador_pistas.copiarOcupacao(quadro.pistas_ocupadas);
+    quadro.numero = proximo_numero++;
+
+    // Gravado antes de publicar: depois disso o buffer pode passar ao renderer
+    if(gravacao.ativo()) {
+        gravacao.gravar(ultimo_passo_ms, quadro);
+    }
+    quadros.publicar();
+
+    metricas.amostrarFila(agora_ms, alocador_pistas.emEspera());
+
+    // Próximo tick ~16 ms reais depois, em qualquer escala: escala × 16 ms
+    // virtuais, contados a partir de agora (o atraso devolvido ao pool conta a
+    // partir do prazo deste passo)
+    int64_t espera_ms = std::max<int64_t>(ATRASO_MOVIMENTO_MS,
+                                          std::llround(pool.relogio().escala() * ATRASO_MOVIMENTO_MS));
+    return std::max(espera_ms, agora_ms + espera_ms - pool.instanteAtual());
+}
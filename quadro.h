@@ -0,0 +1,62 @@
+#ifndef QUADRO_H
+#define QUADRO_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "aviao.h"
+#include "alocador.h"
+#include "buffer_triplo.h"
+#include "contencao.h"
+#include "grade_conflitos.h"
+#include "metricas.h"
+#include "pool_tarefas.h"
+
+class GravadorSimulacao;
+
+// Cópia consistente do estado da simulação lida pelo renderer
+struct QuadroSimulacao {
+    std::vector<Plane> avioes;
+    std::vector<char> pistas_ocupadas;
+    ContagemConflitos conflitos;        // Pares de aviões em voo próximos demais neste tick
+    uint64_t numero = 0;
+};
+
+// Tick central de passo fixo: avança de uma vez todos os aviões em voo e
+// publica o resultado no buffer triplo. O mutex dos aviões fica travado só
+// durante o avanço e a cópia; o renderer lê o último quadro publicado sem
+// travar nada, então desenhar nunca atrasa os aviões. A cada tick também
+// amostra a fila de espera por pistas e conta os conflitos entre aviões em voo
+// (a grade é montada sob o mutex e consultada depois dele).
+//
+// O passo dos aviões continua sendo de 16 ms virtuais, mas o tick roda a cada
+// ~16 ms reais em qualquer escala (escala × 16 ms virtuais): com o relógio
+// acelerado, ele avança de uma vez, em forma fechada, todos os passos vencidos
+// e publica só o resultado. A posição dos aviões acompanha o tempo virtual sem
+// publicar mais de um quadro por quadro desenhado.
+//
+// Com a gravação ativa, cada quadro publicado também vai para o arquivo.
+class TickSimulacao : public TarefaPool {
+public:
+    TickSimulacao(RegistroAvioes& avioes, FrotaAerea& frota, std::mutex& mutex_avioes, ContadorContencao& contencao,
+                  const AlocadorRecursos& alocador_pistas, BufferTriplo<QuadroSimulacao>& quadros,
+                  RegistroMetricas& metricas, const PoolTarefas& pool, GravadorSimulacao& gravacao);
+
+    int64_t executar() override;
+
+private:
+    RegistroAvioes& avioes;
+    FrotaAerea& frota;
+    std::mutex& mutex_avioes;
+    ContadorContencao& contencao;
+    const AlocadorRecursos& alocador_pistas;
+    BufferTriplo<QuadroSimulacao>& quadros;
+    RegistroMetricas& metricas;
+    const PoolTarefas& pool;
+    GravadorSimulacao& gravacao;
+    GradeConflitos grade_conflitos;
+    uint64_t proximo_numero;
+    int64_t ultimo_passo_ms;    // Instante virtual do último passo aplicado (-1: nenhum)
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include "rastro.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+size_t AnelRastro::retirar(EventoRastro* destino, size_t maximo) {
+    uint64_t posicao = cauda.load(std::memory_order_relaxed);
+    uint64_t disponiveis = cabeca.load(std::memory_order_acquire) - posicao;
+    size_t n = static_cast<size_t>(std::min<uint64_t>(disponiveis, maximo));
+    for(size_t i = 0; i < n; ++i) {
+        destino[i] = eventos[(posicao + i) & (CAPACIDADE - 1)];
+    }
+    cauda.store(posicao + n, std::memory_order_release);
+    return n;
+}
+
+uint64_t AnelRastro::retirarPerdidos() {
+    uint64_t total = perdidos.load(std::memory_order_relaxed);
+    uint64_t novos = total - perdidos_informados;
+    perdidos_informados = total;
+    return novos;
+}
+
+namespace {
+
+std::atomic<uint64_t> proximo_identificador{1};
+
+// Anel mais recente da thread, válido enquanto o rastreador for o mesmo
+struct CacheAnel {
+    uint64_t rastreador = 0;
+    AnelRastro* anel = nullptr;
+};
+thread_local CacheAnel cache_anel;
+
+uint64_t agoraNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+}
+
+Rastreador::Rastreador()
+    : identificador(proximo_identificador.fetch_add(1)), arquivo(nullptr), aberto(false), parando(false) {}
+
+Rastreador::~Rastreador() {
+    encerrar();
+}
+
+bool Rastreador::abrir(const std::string& caminho) {
+    arquivo = std::fopen(caminho.c_str(), "wb");
+    if(!arquivo) {
+        return false;
+    }
+    std::fwrite(ASSINATURA_RASTRO, 1, sizeof(ASSINATURA_RASTRO), arquivo);
+    lote.resize(AnelRastro::CAPACIDADE);
+    parando = false;
+    drenador = std::thread(&Rastreador::loopDrenagem, this);
+    aberto.store(true, std::memory_order_release);
+    return true;
+}
+
+void Rastreador::encerrar() {
+    if(!arquivo) {
+        return;
+    }
+    aberto.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex_drenador);
+        parando = true;
+    }
+    cond_drenador.notify_one();
+    drenador.join();
+    drenar();
+    std::fclose(arquivo);
+    arquivo = nullptr;
+}
+
+AnelRastro& Rastreador::anelDaThread() {
+    if(cache_anel.rastreador == identificador) {
+        return *cache_anel.anel;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_aneis);
+    std::thread::id esta_thread = std::this_thread::get_id();
+    AnelRastro* anel = nullptr;
+    for(const auto& existente : aneis) {
+        if(existente.first == esta_thread) {
+            anel = existente.second.get();
+            break;
+        }
+    }
+    if(!anel) {
+        aneis.emplace_back(esta_thread, std::unique_ptr<AnelRastro>(new AnelRastro));
+        anel = aneis.back().second.get();
+    }
+    cache_anel.rastreador = identificador;
+    cache_anel.anel = anel;
+    return *anel;
+}
+
+void Rastreador::registrar(TipoRastro tipo, uint32_t aviao, uint16_t pista) {
+    if(!aberto.load(std::memory_order_acquire)) {
+        return;
+    }
+    EventoRastro evento;
+    evento.tempo_ns = agoraNs();
+    evento.aviao = aviao;
+    evento.pista = pista;
+    evento.tipo = static_cast<uint8_t>(tipo);
+    evento.reservado = 0;
+    anelDaThread().inserir(evento);
+}
+
+void Rastreador::loopDrenagem() {
+    std::unique_lock<std::mutex> lock(mutex_drenador);
+    while(!parando) {
+        cond_drenador.wait_for(lock, std::chrono::milliseconds(INTERVALO_DRENAGEM_MS));
+        lock.unlock();
+        drenar();
+        lock.lock();
+    }
+}
+
+// Copia cada anel para o arquivo em lotes; os eventos descartados viram um registro próprio
+void Rastreador::drenar() {
+    std::lock_guard<std::mutex> lock(mutex_aneis);
+    for(auto& par : aneis) {
+        AnelRastro& anel = *par.second;
+        size_t n;
+        while((n = anel.retirar(lote.data(), lote.size())) > 0) {
+            std::fwrite(lote.data(), sizeof(EventoRastro), n, arquivo);
+        }
+        if(uint64_t perdidos = anel.retirarPerdidos()) {
+            EventoRastro aviso = {agoraNs(), static_cast<uint32_t>(std::min<uint64_t>(perdidos, UINT32_MAX)), 0,
+                                  static_cast<uint8_t>(TipoRastro::EVENTOS_PERDIDOS), 0};
+            std::fwrite(&aviso, sizeof(aviso), 1, arquivo);
+        }
+    }
+    std::fflush(arquivo);
+}
+
+void imprimirEventoRastro(std::ostream& saida, const EventoRastro& evento) {
+    switch(static_cast<TipoRastro>(evento.tipo)) {
+        case TipoRastro::INICIO_VOO:
+            saida << "Avião " << evento.aviao << " iniciando voo.\n";
+            break;
+        case TipoRastro::SOLICITA_POUSO:
+            saida << "Avião " << evento.aviao << " solicitando pouso...\n";
+            break;
+        case TipoRastro::AGUARDANDO_PISTA:
+            saida << "Avião " << evento.aviao << " aguardando pista disponível.\n";
+            break;
+        case TipoRastro::PISTA_ATRIBUIDA:
+            saida << "Avião " << evento.aviao << " atribuído à Pista " << evento.pista << ".\n";
+            break;
+        case TipoRastro::PISTA_ATRIBUIDA_APOS_ESPERA:
+            saida << "Avião " << evento.aviao << " atribuído à Pista " << evento.pista << " após esperar.\n";
+            break;
+        case TipoRastro::POUSOU:
+            saida << "Avião " << evento.aviao << " pousou na pista " << evento.pista << ".\n";
+            break;
+        case TipoRastro::DECOLANDO:
+            saida << "Avião " << evento.aviao << " decolando da pista " << evento.pista << "...\n";
+            break;
+        case TipoRastro::LIBEROU_PISTA:
+            saida << "Avião " << evento.aviao << " liberou a pista " << evento.pista << ".\n";
+            break;
+        case TipoRastro::EVENTOS_PERDIDOS:
+            saida << "(" << evento.aviao << " eventos descartados: anel de rastro cheio)\n";
+            break;
+        case TipoRastro::CHEGOU_PORTAO:
+            saida << "Avião " << evento.aviao << " desembarcando no portão " << evento.pista << ".\n";
+            break;
+        case TipoRastro::SAIU_PORTAO:
+            saida << "Avião " << evento.aviao << " deixou o portão " << evento.pista << ".\n";
+            break;
+        default:
+            saida << "(evento desconhecido " << static_cast<int>(evento.tipo) << ")\n";
+            break;
+    }
+}
+
+bool lerRastro(const std::string& caminho, std::vector<EventoRastro>& eventos) {
+    std::FILE* arquivo = std::fopen(caminho.c_str(), "rb");
+    if(!arquivo) {
+        return false;
+    }
+    char assinatura[sizeof(ASSINATURA_RASTRO)];
+    if(std::fread(assinatura, 1, sizeof(assinatura), arquivo) != sizeof(assinatura) ||
+       std::memcmp(assinatura, ASSINATURA_RASTRO, sizeof(assinatura)) != 0) {
+        std::fclose(arquivo);
+        return false;
+    }
+
+    EventoRastro bloco[4096];
+    size_t n;
+    while((n = std::fread(bloco, sizeof(EventoRastro), 4096, arquivo)) > 0) {
+        eventos.insert(eventos.end(), bloco, bloco + n);
+    }
+    std::fclose(arquivo);
+
+    // Cada anel é drenado em lotes: a ordem global vem do relógio
+    std::stable_sort(eventos.begin(), eventos.end(), [](const EventoRastro& a, const EventoRastro& b) {
+        return a.tempo_ns < b.tempo_ns;
+    });
+    return true;
+}
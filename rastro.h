@@ -0,0 +1,126 @@
+#ifndef RASTRO_H
+#define RASTRO_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Tipos de evento do rastro; cada um corresponde a uma mensagem que aviao()
+// imprimia com std::cout
+enum class TipoRastro : uint8_t {
+    INICIO_VOO,
+    SOLICITA_POUSO,
+    AGUARDANDO_PISTA,
+    PISTA_ATRIBUIDA,
+    PISTA_ATRIBUIDA_APOS_ESPERA,
+    POUSOU,
+    DECOLANDO,
+    LIBEROU_PISTA,
+    EVENTOS_PERDIDOS,       // Escrito pelo drenador: 'aviao' guarda quantos eventos um anel descartou
+    CHEGOU_PORTAO,          // Com portões, 'pista' guarda o ID do portão
+    SAIU_PORTAO
+};
+
+// Evento binário compacto (16 bytes), gravado no arquivo como está
+struct EventoRastro {
+    uint64_t tempo_ns;      // Relógio monotônico
+    uint32_t aviao;
+    uint16_t pista;         // ID da pista (0 quando não se aplica)
+    uint8_t tipo;
+    uint8_t reservado;
+};
+static_assert(sizeof(EventoRastro) == 16, "EventoRastro deve ter 16 bytes");
+
+// Cabeçalho do arquivo de rastro
+constexpr char ASSINATURA_RASTRO[8] = {'R', 'A', 'S', 'T', 'R', 'O', '0', '1'};
+
+// Anel de um produtor (a thread dona) e um consumidor (o drenador), sem locks.
+// Cheio, o evento é descartado e contado: quem registra nunca espera.
+class AnelRastro {
+public:
+    static constexpr size_t CAPACIDADE = 1 << 14;   // Potência de dois
+
+    AnelRastro() : cabeca(0), cauda(0), perdidos(0) {}
+
+    bool inserir(const EventoRastro& evento) {
+        uint64_t posicao = cabeca.load(std::memory_order_relaxed);
+        if(posicao - cauda.load(std::memory_order_acquire) >= CAPACIDADE) {
+            perdidos.store(perdidos.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        eventos[posicao & (CAPACIDADE - 1)] = evento;
+        cabeca.store(posicao + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Copia até 'maximo' eventos para o destino e devolve quantos foram copiados
+    size_t retirar(EventoRastro* destino, size_t maximo);
+
+    // Eventos descartados desde a última chamada
+    uint64_t retirarPerdidos();
+
+private:
+    alignas(64) std::atomic<uint64_t> cabeca;   // Escrita só pelo produtor
+    alignas(64) std::atomic<uint64_t> cauda;    // Escrita só pelo drenador
+    std::atomic<uint64_t> perdidos;
+    uint64_t perdidos_informados = 0;
+    std::array<EventoRastro, CAPACIDADE> eventos;
+};
+
+// Rastro de eventos da simulação. Cada thread que registra ganha seu próprio
+// anel no primeiro uso; uma thread de fundo drena todos os anéis para o
+// arquivo periodicamente. Registrar custa uma leitura de relógio e uma cópia
+// de 16 bytes, sem lock e sem E/S na thread do avião.
+class Rastreador {
+public:
+    static constexpr int INTERVALO_DRENAGEM_MS = 20;
+
+    Rastreador();
+    ~Rastreador();
+
+    Rastreador(const Rastreador&) = delete;
+    Rastreador& operator=(const Rastreador&) = delete;
+
+    // Abre o arquivo e inicia o drenador; até lá registrar não faz nada
+    bool abrir(const std::string& caminho);
+
+    // Para o drenador, drena o que restou e fecha o arquivo; quem registra já deve ter parado
+    void encerrar();
+
+    bool ativo() const { return aberto.load(std::memory_order_relaxed); }
+
+    void registrar(TipoRastro tipo, uint32_t aviao, uint16_t pista = 0);
+
+private:
+    AnelRastro& anelDaThread();
+    void loopDrenagem();
+    void drenar();
+
+    const uint64_t identificador;       // Distingue rastreadores que reaproveitam o mesmo endereço
+    std::FILE* arquivo;
+    std::atomic<bool> aberto;
+    std::mutex mutex_aneis;             // Criação de anéis e drenagem
+    std::vector<std::pair<std::thread::id, std::unique_ptr<AnelRastro>>> aneis;
+    std::vector<EventoRastro> lote;     // Buffer do drenador
+
+    std::mutex mutex_drenador;
+    std::condition_variable cond_drenador;
+    bool parando;
+    std::thread drenador;
+};
+
+// Escreve a mensagem legível de um evento, como aviao() imprimia
+void imprimirEventoRastro(std::ostream& saida, const EventoRastro& evento);
+
+// Lê um arquivo de rastro inteiro, em ordem de tempo
+bool lerRastro(const std::string& caminho, std::vector<EventoRastro>& eventos);
+
+#endif
@@ -0,0 +1,200 @@
+#include "rede.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include "metricas.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+BarreiraRede::BarreiraRede(unsigned participantes)
+    : participantes(participantes), chegaram(0), geracao(0), parcial{SEM_EVENTOS_MS, false},
+      resultado{SEM_EVENTOS_MS, false} {}
+
+BarreiraRede::Votacao BarreiraRede::esperar(int64_t valor, bool sinal) {
+    std::unique_lock<std::mutex> lock(mutex);
+    parcial.minimo = std::min(parcial.minimo, valor);
+    parcial.algum = parcial.algum || sinal;
+    if(++chegaram == participantes) {
+        // O último a chegar publica a votação e abre a próxima geração
+        resultado = parcial;
+        parcial = Votacao{SEM_EVENTOS_MS, false};
+        chegaram = 0;
+        geracao++;
+        cond.notify_all();
+        return resultado;
+    }
+    uint64_t minha_geracao = geracao;
+    cond.wait(lock, [&] { return geracao != minha_geracao; });
+    return resultado;
+}
+
+SimulacaoRede::SimulacaoRede(const Configuracao& config, const ConfiguracaoRede& rede)
+    : config(config), rede(rede), janelas(0), rodadas_extras(0) {
+    this->rede.aeroportos = std::max(1, rede.aeroportos);
+    this->rede.tempo_voo_ms = std::max<int64_t>(1, rede.tempo_voo_ms);
+    int aeroportos = this->rede.aeroportos;
+
+    threads = rede.threads ? rede.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, static_cast<unsigned>(aeroportos));
+
+    for(int a = 0; a < aeroportos; ++a) {
+        simulacoes.emplace_back(new SimulacaoHeadless(config, a, this->rede.escalas));
+    }
+    for(size_t i = 0; i < static_cast<size_t>(aeroportos) * threads; ++i) {
+        aneis.emplace_back(new AnelTransferencias);
+    }
+    chegadas.resize(aeroportos);
+    trabalhadores.resize(threads);
+    for(int a = 0; a < aeroportos; ++a) {
+        trabalhadores[a % threads].aeroportos.push_back(a);
+    }
+    barreira.reset(new BarreiraRede(threads));
+}
+
+int SimulacaoRede::distancia(int origem, int destino) const {
+    int d = std::abs(origem - destino);
+    return std::max(1, std::min(d, rede.aeroportos - d));
+}
+
+ResultadoRede SimulacaoRede::executar() {
+    auto inicio = std::chrono::steady_clock::now();
+    for(auto& simulacao : simulacoes) {
+        simulacao->iniciar();
+    }
+
+    std::vector<std::thread> grupo;
+    for(unsigned t = 0; t < threads; ++t) {
+        grupo.emplace_back(&SimulacaoRede::trabalhar, this, t);
+    }
+    for(std::thread& t : grupo) {
+        t.join();
+    }
+
+    ResultadoRede resultado;
+    HistogramaLatencia espera;
+    for(auto& simulacao : simulacoes) {
+        ResultadoSimulacao aeroporto = simulacao->concluir();
+        resultado.avioes_concluidos += aeroporto.avioes_concluidos;
+        resultado.pousos += aeroporto.espera.atendidos;
+        resultado.eventos_processados += aeroporto.eventos_processados;
+        resultado.tempo_simulado_ms = std::max(resultado.tempo_simulado_ms, aeroporto.tempo_simulado_ms);
+        simulacao->metricas().combinar(Latencia::ESPERA_PISTA, espera);
+        resultado.aeroportos.push_back(aeroporto);
+    }
+    for(const Trabalhador& trabalhador : trabalhadores) {
+        resultado.transferencias += trabalhador.transferencias;
+    }
+    resultado.espera.atendidos = espera.contagem();
+    resultado.espera.media_ms = espera.media();
+    resultado.espera.p50_ms = espera.percentil(50);
+    resultado.espera.p95_ms = espera.percentil(95);
+    resultado.espera.p99_ms = espera.percentil(99);
+    resultado.espera.maxima_ms = espera.maximo();
+    resultado.janelas = janelas;
+    resultado.rodadas_extras = rodadas_extras;
+    resultado.threads = threads;
+    resultado.tempo_parede_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return resultado;
+}
+
+// Laço de uma thread de trabalho: janela a janela, simula os seus aeroportos,
+// entrega as decolagens e recebe as chegadas
+void SimulacaoRede::trabalhar(unsigned indice) {
+    fixarNucleo(indice);
+    Trabalhador& eu = trabalhadores[indice];
+
+    int64_t proximo_ms = SEM_EVENTOS_MS;
+    for(int a : eu.aeroportos) {
+        proximo_ms = std::min(proximo_ms, simulacoes[a]->proximoEvento());
+    }
+    int64_t inicio_janela = barreira->esperar(proximo_ms, false).minimo;
+
+    while(inicio_janela != SEM_EVENTOS_MS) {
+        // Nada do que decolar antes do limite chega antes dele
+        int64_t limite = inicio_janela + rede.tempo_voo_ms;
+        for(int a : eu.aeroportos) {
+            SimulacaoHeadless& simulacao = *simulacoes[a];
+            simulacao.executarAte(limite);
+            for(AviaoEmTransito& aviao : simulacao.partidas()) {
+                // O destino sai da sequência do próprio avião: independe da ordem das threads
+                int salto = 1 + static_cast<int>(aviao.gerador.uniforme(static_cast<uint32_t>(rede.aeroportos - 1)));
+                aviao.destino = (aviao.origem + salto) % rede.aeroportos;
+                aviao.chegada_ms = aviao.partida_ms + rede.tempo_voo_ms * distancia(aviao.origem, aviao.destino);
+                eu.transferencias++;
+                despachar(eu, indice, aviao);
+            }
+            simulacao.partidas().clear();
+        }
+
+        // Entrega: enquanto alguém tiver aviões que não couberam, todos esvaziam
+        // os anéis dos seus aeroportos e quem sobrou tenta de novo
+        BarreiraRede::Votacao votacao = barreira->esperar(0, !eu.pendentes.empty());
+        for(int a : eu.aeroportos) {
+            drenar(a);
+        }
+        while(votacao.algum) {
+            if(indice == 0) {
+                rodadas_extras++;
+            }
+            std::vector<AviaoEmTransito> reenviar;
+            reenviar.swap(eu.pendentes);
+            for(const AviaoEmTransito& aviao : reenviar) {
+                despachar(eu, indice, aviao);
+            }
+            votacao = barreira->esperar(0, !eu.pendentes.empty());
+            for(int a : eu.aeroportos) {
+                drenar(a);
+            }
+        }
+
+        // Chegadas em ordem de instante e ID, qualquer que seja a thread de origem
+        proximo_ms = SEM_EVENTOS_MS;
+        for(int a : eu.aeroportos) {
+            std::vector<AviaoEmTransito>& recebidos = chegadas[a];
+            std::sort(recebidos.begin(), recebidos.end(), [](const AviaoEmTransito& x, const AviaoEmTransito& y) {
+                return x.chegada_ms != y.chegada_ms ? x.chegada_ms < y.chegada_ms : x.id < y.id;
+            });
+            for(const AviaoEmTransito& aviao : recebidos) {
+                simulacoes[a]->receber(aviao);
+            }
+            recebidos.clear();
+            proximo_ms = std::min(proximo_ms, simulacoes[a]->proximoEvento());
+        }
+
+        inicio_janela = barreira->esperar(proximo_ms, false).minimo;
+        if(indice == 0) {
+            janelas++;
+        }
+    }
+}
+
+void SimulacaoRede::despachar(Trabalhador& trabalhador, unsigned indice, AviaoEmTransito aviao) {
+    if(!anel(aviao.destino, indice).inserir(aviao)) {
+        trabalhador.pendentes.push_back(aviao);
+    }
+}
+
+void SimulacaoRede::drenar(int aeroporto) {
+    AviaoEmTransito aviao;
+    for(unsigned origem = 0; origem < threads; ++origem) {
+        while(anel(aeroporto, origem).retirar(aviao)) {
+            chegadas[aeroporto].push_back(aviao);
+        }
+    }
+}
+
+void fixarNucleo(unsigned nucleo) {
+#ifdef __linux__
+    unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(nucleo % nucleos, &conjunto);
+    pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto);
+#else
+    (void)nucleo;
+#endif
+}
@@ -0,0 +1,144 @@
+#ifndef REDE_H
+#define REDE_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "configuracao.h"
+#include "simulacao.h"
+
+// Parâmetros da rede de aeroportos (além da Configuracao de cada aeroporto)
+struct ConfiguracaoRede {
+    int aeroportos = 1;
+    int64_t tempo_voo_ms = 60000;   // Voo entre aeroportos vizinhos; o mínimo entre dois aeroportos
+    int escalas = 3;                // Decolagens de cada avião que seguem para outro aeroporto
+    unsigned threads = 0;           // 0: uma por núcleo (no máximo uma por aeroporto)
+};
+
+// Resultado da rede: cada aeroporto e os totais
+struct ResultadoRede {
+    std::vector<ResultadoSimulacao> aeroportos;
+    int avioes_concluidos = 0;      // Aviões que terminaram a última escala
+    uint64_t pousos = 0;
+    uint64_t eventos_processados = 0;
+    uint64_t transferencias = 0;    // Aviões entregues de um aeroporto a outro
+    uint64_t janelas = 0;           // Janelas de tempo sincronizadas
+    uint64_t rodadas_extras = 0;    // Rodadas a mais porque um anel encheu
+    int64_t tempo_simulado_ms = 0;
+    EstatisticasEspera espera;      // Esperas por pista de todos os aeroportos
+    unsigned threads = 0;
+    double tempo_parede_s = 0.0;
+};
+
+// Anel de transferências de uma thread de trabalho para um aeroporto, sem
+// locks (um produtor e um consumidor). Cheio, inserir falha e o avião fica com
+// quem produziu até a próxima rodada de entrega.
+class AnelTransferencias {
+public:
+    static constexpr size_t CAPACIDADE = 256;   // Potência de dois
+
+    AnelTransferencias() : cabeca(0), cauda(0) {}
+
+    bool inserir(const AviaoEmTransito& aviao) {
+        uint64_t posicao = cabeca.load(std::memory_order_relaxed);
+        if(posicao - cauda.load(std::memory_order_acquire) >= CAPACIDADE) {
+            return false;
+        }
+        avioes[posicao & (CAPACIDADE - 1)] = aviao;
+        cabeca.store(posicao + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool retirar(AviaoEmTransito& aviao) {
+        uint64_t posicao = cauda.load(std::memory_order_relaxed);
+        if(posicao == cabeca.load(std::memory_order_acquire)) {
+            return false;
+        }
+        aviao = avioes[posicao & (CAPACIDADE - 1)];
+        cauda.store(posicao + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> cabeca;   // Escrita só pelo produtor
+    alignas(64) std::atomic<uint64_t> cauda;    // Escrita só pelo consumidor
+    std::array<AviaoEmTransito, CAPACIDADE> avioes;
+};
+
+// Barreira reutilizável das threads de trabalho que também combina um valor de
+// cada uma: todas recebem o menor instante e se alguma sinalizou
+class BarreiraRede {
+public:
+    struct Votacao {
+        int64_t minimo;
+        bool algum;
+    };
+
+    explicit BarreiraRede(unsigned participantes);
+
+    Votacao esperar(int64_t valor, bool sinal);
+
+private:
+    std::mutex mutex;
+    std::condition_variable cond;
+    const unsigned participantes;
+    unsigned chegaram;
+    uint64_t geracao;
+    Votacao parcial;
+    Votacao resultado;
+};
+
+// Rede de aeroportos simulada em paralelo. Cada aeroporto é uma
+// SimulacaoHeadless com seus próprios aviões, pistas e alocador, sem nada
+// compartilhado com os outros; as threads de trabalho, fixadas em núcleos
+// diferentes, dividem os aeroportos entre si.
+//
+// A sincronização é conservadora por janelas de tempo virtual do tamanho do
+// menor voo entre dois aeroportos: um avião que decola dentro da janela só
+// chega depois dela, então cada thread processa a janela inteira dos seus
+// aeroportos sem esperar as outras. As decolagens vão para anéis sem lock (um
+// por thread de origem e aeroporto de destino) e são entregues na barreira
+// entre janelas, ordenadas por chegada e ID; o resultado não depende do
+// número de threads. Janelas sem nenhum evento são puladas.
+class SimulacaoRede {
+public:
+    SimulacaoRede(const Configuracao& config, const ConfiguracaoRede& rede);
+
+    ResultadoRede executar();
+
+    // Distância em voos mínimos entre dois aeroportos (dispostos em anel)
+    int distancia(int origem, int destino) const;
+
+private:
+    // Estado de uma thread de trabalho, em linhas de cache separadas
+    struct alignas(64) Trabalhador {
+        std::vector<int> aeroportos;
+        std::vector<AviaoEmTransito> pendentes;     // Não couberam no anel do destino
+        uint64_t transferencias = 0;
+    };
+
+    void trabalhar(unsigned indice);
+    void despachar(Trabalhador& trabalhador, unsigned indice, AviaoEmTransito aviao);
+    void drenar(int aeroporto);
+    AnelTransferencias& anel(int destino, unsigned origem) { return *aneis[destino * threads + origem]; }
+
+    Configuracao config;
+    ConfiguracaoRede rede;
+    unsigned threads;
+    std::vector<std::unique_ptr<SimulacaoHeadless>> simulacoes;
+    std::vector<std::unique_ptr<AnelTransferencias>> aneis;
+    std::vector<std::vector<AviaoEmTransito>> chegadas;     // Retiradas dos anéis, por aeroporto
+    std::vector<Trabalhador> trabalhadores;
+    std::unique_ptr<BarreiraRede> barreira;
+    uint64_t janelas;
+    uint64_t rodadas_extras;
+};
+
+// Fixa a thread atual em um núcleo (só no Linux; nos demais não faz nada)
+void fixarNucleo(unsigned nucleo);
+
+#endif
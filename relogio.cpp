@@ -0,0 +1,110 @@
+#include "relogio.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+int64_t agoraRealNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        RelogioSimulacao::Real::now().time_since_epoch()).count();
+}
+
+double limitarEscala(double escala) {
+    return std::min(RelogioSimulacao::ESCALA_MAXIMA, std::max(RelogioSimulacao::ESCALA_MINIMA, escala));
+}
+
+// Sequência 1-2-5 entre as escalas mínima e máxima
+const double ESCALAS[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+
+} // namespace
+
+RelogioSimulacao::RelogioSimulacao(double escala)
+    : versao(0), base_real_ns(agoraRealNs()), base_virtual_ns(0), escala_atual(limitarEscala(escala)),
+      proximo_identificador(0) {}
+
+// Copia o ponto de mudança; repete se uma escrita aconteceu no meio da leitura
+RelogioSimulacao::Ponto RelogioSimulacao::lerPonto() const {
+    Ponto ponto;
+    uint64_t antes, depois;
+    do {
+        antes = versao.load(std::memory_order_acquire);
+        ponto.real_ns = base_real_ns.load(std::memory_order_relaxed);
+        ponto.virtual_ns = base_virtual_ns.load(std::memory_order_relaxed);
+        ponto.escala = escala_atual.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        depois = versao.load(std::memory_order_relaxed);
+    } while(antes != depois || (antes & 1));
+    return ponto;
+}
+
+int64_t RelogioSimulacao::agoraMs() const {
+    Ponto ponto = lerPonto();
+    double decorrido_ns = static_cast<double>(agoraRealNs() - ponto.real_ns) * ponto.escala;
+    return (ponto.virtual_ns + static_cast<int64_t>(decorrido_ns)) / 1000000;
+}
+
+RelogioSimulacao::Real::time_point RelogioSimulacao::instanteReal(int64_t virtual_ms) const {
+    Ponto ponto = lerPonto();
+    double falta_ns = static_cast<double>(virtual_ms * 1000000 - ponto.virtual_ns) / ponto.escala;
+    int64_t real_ns = ponto.real_ns + static_cast<int64_t>(std::ceil(std::max(0.0, falta_ns)));
+    return Real::time_point(std::chrono::duration_cast<Real::duration>(std::chrono::nanoseconds(real_ns)));
+}
+
+void RelogioSimulacao::definirEscala(double escala) {
+    escala = limitarEscala(escala);
+    std::lock_guard<std::mutex> lock(mutex);
+    int64_t real_ns = agoraRealNs();
+    Ponto ponto = lerPonto();
+    int64_t virtual_ns = ponto.virtual_ns +
+                         static_cast<int64_t>(static_cast<double>(real_ns - ponto.real_ns) * ponto.escala);
+
+    uint64_t v = versao.load(std::memory_order_relaxed);
+    versao.store(v + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    base_real_ns.store(real_ns, std::memory_order_relaxed);
+    base_virtual_ns.store(virtual_ns, std::memory_order_relaxed);
+    escala_atual.store(escala, std::memory_order_relaxed);
+    versao.store(v + 2, std::memory_order_release);
+
+    // Avisos sob o mutex: deixarDeObservar espera o aviso em andamento, então o
+    // observador pode ser destruído logo depois. O aviso não pode mudar a escala.
+    for(const auto& observador : observadores) {
+        observador.second();
+    }
+}
+
+int RelogioSimulacao::observar(std::function<void()> aviso) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int identificador = proximo_identificador++;
+    observadores.emplace_back(identificador, std::move(aviso));
+    return identificador;
+}
+
+void RelogioSimulacao::deixarDeObservar(int identificador) {
+    std::lock_guard<std::mutex> lock(mutex);
+    observadores.erase(std::remove_if(observadores.begin(), observadores.end(),
+                                      [identificador](const std::pair<int, std::function<void()>>& observador) {
+                                          return observador.first == identificador;
+                                      }),
+                       observadores.end());
+}
+
+double proximaEscala(double escala) {
+    for(double candidata : ESCALAS) {
+        if(candidata > escala) {
+            return candidata;
+        }
+    }
+    return RelogioSimulacao::ESCALA_MAXIMA;
+}
+
+double escalaAnterior(double escala) {
+    double anterior = RelogioSimulacao::ESCALA_MINIMA;
+    for(double candidata : ESCALAS) {
+        if(candidata >= escala) {
+            break;
+        }
+        anterior = candidata;
+    }
+    return anterior;
+}
@@ -0,0 +1,73 @@
+#ifndef RELOGIO_H
+#define RELOGIO_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Relógio da simulação: todo prazo dos aviões, do tick e das métricas é medido
+// em milissegundos virtuais, que avançam `escala` vezes mais rápido que o tempo
+// real. A escala pode mudar durante a execução sem saltos: o relógio guarda o
+// último ponto de mudança (instante real, instante virtual) e extrapola a
+// partir dele. Como os aviões só veem tempo virtual, a mesma configuração dá o
+// mesmo resultado a 1x ou a 1000x.
+//
+// A leitura é sem lock (seqlock sobre o ponto de mudança); só definirEscala trava.
+class RelogioSimulacao {
+public:
+    static constexpr double ESCALA_MINIMA = 1.0;
+    static constexpr double ESCALA_MAXIMA = 1000.0;
+
+    using Real = std::chrono::steady_clock;
+
+    explicit RelogioSimulacao(double escala = 1.0);
+
+    RelogioSimulacao(const RelogioSimulacao&) = delete;
+    RelogioSimulacao& operator=(const RelogioSimulacao&) = delete;
+
+    // Milissegundos virtuais desde a criação do relógio
+    int64_t agoraMs() const;
+
+    double escala() const { return escala_atual.load(std::memory_order_relaxed); }
+
+    // Muda a velocidade (limitada a [ESCALA_MINIMA, ESCALA_MAXIMA]) sem alterar o
+    // instante virtual atual e avisa os observadores, que reavaliam seus prazos
+    void definirEscala(double escala);
+
+    // Instante real em que o relógio chega a `virtual_ms` com a escala atual
+    Real::time_point instanteReal(int64_t virtual_ms) const;
+
+    // Registra uma função chamada depois de cada mudança de escala; devolve o
+    // identificador usado para cancelar o registro
+    int observar(std::function<void()> aviso);
+    void deixarDeObservar(int identificador);
+
+private:
+    struct Ponto {
+        int64_t real_ns;
+        int64_t virtual_ns;
+        double escala;
+    };
+
+    Ponto lerPonto() const;
+
+    // Ponto da última mudança de escala; versão ímpar durante a escrita
+    std::atomic<uint64_t> versao;
+    std::atomic<int64_t> base_real_ns;
+    std::atomic<int64_t> base_virtual_ns;
+    std::atomic<double> escala_atual;
+
+    std::mutex mutex;   // Serializa as mudanças de escala e protege os observadores
+    std::vector<std::pair<int, std::function<void()>>> observadores;
+    int proximo_identificador;
+};
+
+// Escala seguinte/anterior na sequência 1, 2, 5, 10, 20, 50, ... usada pelos
+// controles de velocidade da janela
+double proximaEscala(double escala);
+double escalaAnterior(double escala);
+
+#endif
@@ -0,0 +1,65 @@
+#include "ritmo_quadros.h"
+#include <thread>
+
+namespace {
+
+int64_t microssegundos(RitmoQuadros::Relogio::duration duracao) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duracao).count();
+}
+
+} // namespace
+
+RitmoQuadros::RitmoQuadros(int quadros_por_segundo)
+    : periodo(std::chrono::duration_cast<Relogio::duration>(std::chrono::seconds(1)) / quadros_por_segundo),
+      houve_quadro(false), pulados(0) {
+    reiniciar();
+}
+
+void RitmoQuadros::reiniciar() {
+    prazo = Relogio::now();
+    houve_quadro = false;
+    pulados = 0;
+    custo_us.zerar();
+    intervalo_us.zerar();
+}
+
+int RitmoQuadros::msAtePrazo() const {
+    Relogio::duration falta = prazo - Relogio::now();
+    if(falta <= Relogio::duration::zero()) {
+        return 0;
+    }
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(falta).count());
+}
+
+void RitmoQuadros::esperarPrazo() const {
+    std::this_thread::sleep_until(prazo);
+}
+
+void RitmoQuadros::iniciarQuadro() {
+    inicio_quadro = Relogio::now();
+    if(houve_quadro) {
+        intervalo_us.registrar(microssegundos(inicio_quadro - inicio_anterior));
+    }
+    inicio_anterior = inicio_quadro;
+    houve_quadro = true;
+}
+
+void RitmoQuadros::concluirQuadro() {
+    custo_us.registrar(microssegundos(Relogio::now() - inicio_quadro));
+    avancarPrazo();
+}
+
+void RitmoQuadros::pularQuadro() {
+    pulados++;
+    // O próximo quadro desenhado não mede o intervalo desde um quadro antigo
+    houve_quadro = false;
+    avancarPrazo();
+}
+
+void RitmoQuadros::avancarPrazo() {
+    prazo += periodo;
+    Relogio::time_point agora = Relogio::now();
+    if(prazo + periodo <= agora) {
+        prazo = agora + periodo;
+    }
+}
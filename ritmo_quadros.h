@@ -0,0 +1,57 @@
+#ifndef RITMO_QUADROS_H
+#define RITMO_QUADROS_H
+
+#include <chrono>
+#include <cstdint>
+#include "metricas.h"
+
+// Ritmo dos quadros da janela: em vez de um atraso fixo depois de cada quadro,
+// mantém o prazo do próximo quadro (um período depois do prazo anterior), então
+// o custo variável de desenhar não se soma ao intervalo. O laço principal
+// espera eventos até esse prazo; se um quadro atrasar mais de um período, o
+// prazo é realinhado a partir de agora em vez de desenhar vários quadros
+// seguidos para recuperar.
+//
+// O custo de cada quadro (desenho + apresentação) e o intervalo entre o início
+// de quadros seguidos vão para histogramas em microssegundos.
+class RitmoQuadros {
+public:
+    using Relogio = std::chrono::steady_clock;
+
+    explicit RitmoQuadros(int quadros_por_segundo = 60);
+
+    // Recomeça a contagem de prazos a partir de agora e zera os histogramas
+    // (ao iniciar cada simulação na mesma janela)
+    void reiniciar();
+
+    // Milissegundos inteiros até o prazo do próximo quadro (0 se falta menos de 1 ms)
+    int msAtePrazo() const;
+
+    // Dorme o resto (abaixo de 1 ms) até o prazo, que a espera por eventos não cobre
+    void esperarPrazo() const;
+
+    // Início e fim de um quadro desenhado; o fim avança o prazo
+    void iniciarQuadro();
+    void concluirQuadro();
+
+    // Prazo vencido sem nada novo para desenhar: avança o prazo sem desenhar
+    void pularQuadro();
+
+    const HistogramaLatencia& custo() const { return custo_us; }
+    const HistogramaLatencia& intervalo() const { return intervalo_us; }
+    uint64_t quadrosPulados() const { return pulados; }
+
+private:
+    void avancarPrazo();
+
+    Relogio::duration periodo;
+    Relogio::time_point prazo;
+    Relogio::time_point inicio_quadro;
+    Relogio::time_point inicio_anterior;
+    bool houve_quadro;
+    uint64_t pulados;
+    HistogramaLatencia custo_us;
+    HistogramaLatencia intervalo_us;
+};
+
+#endif
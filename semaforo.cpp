@@ -1,15 +1,91 @@
 #include "semaforo.h"
 
-// Semaphore::Semaphore(int count_) : count(count_) {}
-
-// void Semaphore::notify() {
-//     std::unique_lock<std::mutex> lock(mtx);
-//     count++;
-//     cv.notify_one();
-// }
-
-// void Semaphore::wait() {
-//     std::unique_lock<std::mutex> lock(mtx);
-//     cv.wait(lock, [this]() { return count > 0; });
-//     count--;
-// }
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex precisa de um int de 32 bits");
+
+namespace {
+
+// Dorme enquanto *endereco == esperado; o kernel confere o valor atomicamente
+// antes de dormir, então um notificar() entre a conferência e o futex não se perde
+void futexEsperar(std::atomic<int>& endereco, int esperado, const timespec* limite) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&endereco), FUTEX_WAIT_PRIVATE, esperado, limite, nullptr, 0);
+}
+
+void futexAcordar(std::atomic<int>& endereco, int n) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&endereco), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+}
+
+} // namespace
+#endif
+
+// Anuncia-se em `dormindo` antes de reconferir as licenças: um notificar() que
+// não vê o anúncio somou a licença antes, e a reconferência a encontra
+bool Semaforo::esperar(const std::chrono::steady_clock::time_point* prazo) {
+    auto inicio = std::chrono::steady_clock::now();
+    bool obteve = false;
+
+#ifdef __linux__
+    dormindo.fetch_add(1, std::memory_order_seq_cst);
+    // A releitura relaxada de count não sobe para antes do anúncio; aqui o futex
+    // ainda confere o valor, mas a ordem não depende disso
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while(!(obteve = tentarDecrementar())) {
+        if(!prazo) {
+            futexEsperar(count, 0, nullptr);
+            continue;
+        }
+        auto restante = *prazo - std::chrono::steady_clock::now();
+        if(restante <= std::chrono::steady_clock::duration::zero()) {
+            break;
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(restante).count();
+        timespec limite = { static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000) };
+        futexEsperar(count, 0, &limite);
+    }
+    dormindo.fetch_sub(1, std::memory_order_relaxed);
+#else
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        dormindo.fetch_add(1, std::memory_order_seq_cst);
+        // Sem a cerca, a releitura relaxada de count e o dormindo lido em
+        // notificar() podem não se ver (em ARM e POWER) e o sinal se perde
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while(!(obteve = tentarDecrementar())) {
+            if(!prazo) {
+                cond.wait(lock);
+            } else if(cond.wait_until(lock, *prazo) == std::cv_status::timeout) {
+                obteve = tentarDecrementar();
+                break;
+            }
+        }
+        dormindo.fetch_sub(1, std::memory_order_relaxed);
+    }
+#endif
+
+    auto espera = std::chrono::steady_clock::now() - inicio;
+    if(obteve) {
+        contador.contendidas.fetch_add(1, std::memory_order_relaxed);
+    }
+    contador.espera_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(espera).count(),
+                                 std::memory_order_relaxed);
+    return obteve;
+}
+
+void Semaforo::acordar(int n) {
+#ifdef __linux__
+    futexAcordar(count, n);
+#else
+    // Passar pelo mutex garante que quem reconferiu as licenças sem achar nenhuma
+    // já está dormindo em cond e recebe o sinal
+    { std::lock_guard<std::mutex> lock(mutex); }
+    for(int i = 0; i < n; ++i) {
+        cond.notify_one();
+    }
+#endif
+}
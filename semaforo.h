@@ -1,40 +1,97 @@
 #ifndef SEMAFORO_H
 #define SEMAFORO_H
 
-#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "contencao.h"
 
+#ifndef __linux__
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Semáforo contador. As licenças ficam em um inteiro atômico: adquirir com
+// licença disponível é um CAS e liberar sem ninguém dormindo é um fetch_add,
+// sem lock nem chamada de sistema. Só quem precisa dormir vai ao kernel
+// (futex no Linux; mutex e variável de condição nos demais sistemas).
+// As pistas não passam por aqui: são do AlocadorRecursos. O semáforo fica
+// como classe de biblioteca, medida por bench_semaforo.cpp.
 class Semaforo {
 public:
-    Semaforo(int count = 0) : count(count) {
-        pthread_mutex_init(&mutex, NULL);
-        pthread_cond_init(&cond, NULL);
+    Semaforo(int count = 0) : count(count), dormindo(0) {}
+
+    Semaforo(const Semaforo&) = delete;
+    Semaforo& operator=(const Semaforo&) = delete;
+
+    void wait() {
+        if(!tentarDecrementar()) {
+            esperar(nullptr);
+        }
+        contador.aquisicoes.fetch_add(1, std::memory_order_relaxed);
     }
 
-    ~Semaforo() {
-        pthread_mutex_destroy(&mutex);
-        pthread_cond_destroy(&cond);
+    // Adquire uma licença se houver, sem bloquear
+    bool try_wait() {
+        if(!tentarDecrementar()) {
+            return false;
+        }
+        contador.aquisicoes.fetch_add(1, std::memory_order_relaxed);
+        return true;
     }
 
-    void wait() {
-        pthread_mutex_lock(&mutex);
-        while(count <= 0) {
-            pthread_cond_wait(&cond, &mutex);
+    // Espera no máximo `limite` por uma licença; devolve false se o prazo acabou sem ela
+    template <class Rep, class Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& limite) {
+        if(!tentarDecrementar()) {
+            auto prazo = std::chrono::steady_clock::now() +
+                         std::chrono::duration_cast<std::chrono::steady_clock::duration>(limite);
+            if(!esperar(&prazo)) {
+                return false;
+            }
         }
-        count--;
-        pthread_mutex_unlock(&mutex);
+        contador.aquisicoes.fetch_add(1, std::memory_order_relaxed);
+        return true;
     }
 
-    void notificar() {
-        pthread_mutex_lock(&mutex);
-        count++;
-        pthread_cond_signal(&cond);
-        pthread_mutex_unlock(&mutex);
+    // Devolve n licenças e acorda até n threads dormindo
+    void notificar(int n = 1) {
+        count.fetch_add(n, std::memory_order_seq_cst);
+        if(dormindo.load(std::memory_order_seq_cst) > 0) {
+            acordar(n);
+        }
     }
 
+    // Licenças disponíveis agora (só informativo: pode mudar logo depois)
+    int disponiveis() const { return count.load(std::memory_order_relaxed); }
+
+    // Licenças obtidas, quantas precisaram bloquear e o tempo total bloqueado.
+    // Um wait_for() que esgota o prazo só soma no tempo bloqueado
+    const ContadorContencao& contencao() const { return contador; }
+
 private:
-    int count;
-    pthread_mutex_t mutex;
-    pthread_cond_t cond;
+    bool tentarDecrementar() {
+        int atual = count.load(std::memory_order_relaxed);
+        while(atual > 0) {
+            if(count.compare_exchange_weak(atual, atual - 1, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Caminho lento: dorme até conseguir uma licença ou até o prazo (nullptr = sem prazo)
+    bool esperar(const std::chrono::steady_clock::time_point* prazo);
+    void acordar(int n);
+
+    std::atomic<int> count;         // Nunca fica negativo
+    std::atomic<int> dormindo;      // Threads no caminho lento
+    ContadorContencao contador;
+#ifndef __linux__
+    std::mutex mutex;
+    std::condition_variable cond;
+#endif
 };
 
 #endif
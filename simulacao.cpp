@@ -0,0 +1,298 @@
+#include "simulacao.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+SimulacaoHeadless::SimulacaoHeadless(const Configuracao& config, int aeroporto, int escalas)
+    : config(config), aeroporto(aeroporto), escalas(escalas), agora_ms(0), proxima_sequencia(SEQUENCIA_EVENTOS),
+      chegadas_agendadas(0), primeiro_id(static_cast<uint64_t>(aeroporto) * config.num_avioes + 1),
+      alocador_pistas(config.num_pistas, [this](void* solicitante, int pista) {
+          // A pista liberada foi entregue diretamente a um avião da fila
+          atribuirPista(static_cast<EstadoAviao*>(solicitante)->indice, pista);
+      }, criarPolitica(config.politica_pistas)),
+      alocador_vias(config.num_portoes > 0 ? config.num_vias_taxi : 0, [this](void* solicitante, int via) {
+          atribuirVia(static_cast<EstadoAviao*>(solicitante)->indice, via);
+      }, criarPolitica(config.politica_pistas)),
+      alocador_portoes(config.num_portoes, [this](void* solicitante, int portao) {
+          atribuirPortao(static_cast<EstadoAviao*>(solicitante)->indice, portao);
+      }, criarPolitica(config.politica_pistas)) {
+    std::string erro;
+    fonte_chegadas = criarFonteChegadas(config, aeroporto, erro);
+    if(!fonte_chegadas) {
+        std::cerr << erro << std::endl;
+    }
+    inicio_ocupacao_ms.assign(config.num_pistas, 0);
+    resultado.ocupacao_pistas_ms.assign(config.num_pistas, 0);
+}
+
+// Ocupa a posição de um avião que já decolou ou, se não houver, uma nova no
+// fim de avioes; devolve o índice
+int SimulacaoHeadless::adicionarAviao(uint64_t id, GeradorAviao gerador, int escalas_restantes) {
+    int indice;
+    if(livres.empty()) {
+        indice = static_cast<int>(avioes.size());
+        avioes.emplace_back();
+    } else {
+        indice = livres.back();
+        livres.pop_back();
+        avioes[indice] = EstadoAviao();
+    }
+    EstadoAviao& estado = avioes[indice];
+    estado.indice = indice;
+    estado.id = id;
+    SorteioAviao sorteio = sortearAviao(config, gerador);
+    estado.desembarque_ms = sorteio.desembarque_ms;
+    estado.emergencia = sorteio.emergencia;
+    estado.gerador = gerador;
+    estado.escalas_restantes = escalas_restantes;
+    return indice;
+}
+
+// Agenda a próxima chegada da fonte, se houver
+void SimulacaoHeadless::agendarChegada() {
+    int64_t instante_ms;
+    if(fonte_chegadas && fonte_chegadas->proxima(instante_ms)) {
+        eventos.push({instante_ms, chegadas_agendadas++, -1, TipoEvento::CHEGADA});
+    }
+}
+
+// Cria o avião que chegou, com o mesmo gerador (semente + ID) da versão
+// gráfica, põe no céu e agenda a chegada seguinte
+void SimulacaoHeadless::chegar() {
+    uint64_t id = primeiro_id + chegadas_agendadas - 1;
+    iniciarVoo(adicionarAviao(id, GeradorAviao(config.semente, id), escalas));
+    agendarChegada();
+}
+
+// Avião entra no céu e pede pista ao fim do voo
+void SimulacaoHeadless::iniciarVoo(int aviao) {
+    avioes[aviao].inicio_voo_ms = agora_ms;
+    agendar(agora_ms + static_cast<int64_t>(QUADROS_VOO) * ATRASO_MOVIMENTO_MS, aviao, TipoEvento::SOLICITA_POUSO);
+}
+
+// Chegada de outro aeroporto: novos sorteios na sequência do avião e entrada no céu
+void SimulacaoHeadless::receber(const AviaoEmTransito& aviao) {
+    agendar(aviao.chegada_ms, adicionarAviao(aviao.id, aviao.gerador, aviao.escalas_restantes), TipoEvento::INICIO_VOO);
+}
+
+// Agenda um evento no relógio virtual
+void SimulacaoHeadless::agendar(int64_t tempo_ms, int aviao, TipoEvento tipo) {
+    eventos.push({tempo_ms, proxima_sequencia++, aviao, tipo});
+}
+
+// Pede uma pista para pousar ou, com portões e já desembarcado, para decolar.
+// Sem pista livre o avião fica na fila do alocador até uma ser entregue.
+void SimulacaoHeadless::pedirPista(int aviao) {
+    EstadoAviao& estado = avioes[aviao];
+    estado.pedido_ms = agora_ms;
+    Solicitacao solicitacao;
+    solicitacao.solicitante = &estado;
+    solicitacao.chegada_ms = agora_ms;
+    if(config.num_portoes == 0) {
+        solicitacao.servico_ms = config.tempo_pouso_ms + estado.desembarque_ms
+                               + static_cast<int64_t>(QUADROS_DECOLAGEM) * ATRASO_MOVIMENTO_MS;
+    } else {
+        solicitacao.servico_ms = estado.desembarcou ? static_cast<int64_t>(QUADROS_DECOLAGEM) * ATRASO_MOVIMENTO_MS
+                                                    : config.tempo_pouso_ms;
+    }
+    solicitacao.prioridade = estado.emergencia ? 1 : 0;
+    int pista = alocador_pistas.solicitar(solicitacao, agora_ms);
+    if(pista != -1) {
+        atribuirPista(aviao, pista);
+    }
+    registro_metricas.amostrarFila(agora_ms, alocador_pistas.emEspera());
+}
+
+// Vias sem limite: o táxi começa na hora
+void SimulacaoHeadless::pedirVia(int aviao) {
+    EstadoAviao& estado = avioes[aviao];
+    estado.pedido_ms = agora_ms;
+    if(config.num_vias_taxi == 0) {
+        agendar(agora_ms + config.tempo_taxi_ms, aviao, TipoEvento::FIM_TAXI);
+        return;
+    }
+    Solicitacao solicitacao;
+    solicitacao.solicitante = &estado;
+    solicitacao.chegada_ms = agora_ms;
+    solicitacao.servico_ms = config.tempo_taxi_ms;
+    solicitacao.prioridade = estado.emergencia ? 1 : 0;
+    int via = alocador_vias.solicitar(solicitacao, agora_ms);
+    if(via != -1) {
+        atribuirVia(aviao, via);
+    }
+}
+
+void SimulacaoHeadless::pedirPortao(int aviao) {
+    EstadoAviao& estado = avioes[aviao];
+    estado.pedido_ms = agora_ms;
+    Solicitacao solicitacao;
+    solicitacao.solicitante = &estado;
+    solicitacao.chegada_ms = agora_ms;
+    solicitacao.servico_ms = estado.desembarque_ms;
+    solicitacao.prioridade = estado.emergencia ? 1 : 0;
+    int portao = alocador_portoes.solicitar(solicitacao, agora_ms);
+    if(portao != -1) {
+        atribuirPortao(aviao, portao);
+    }
+}
+
+// Registra a pista recebida do alocador e agenda o fim do pouso (ou da decolagem)
+void SimulacaoHeadless::atribuirPista(int aviao, int pista) {
+    EstadoAviao& estado = avioes[aviao];
+    inicio_ocupacao_ms[pista] = agora_ms;
+    estado.pista = pista;
+    estado.concessao_pista_ms = agora_ms;
+    if(estado.desembarcou) {
+        registro_metricas.registrar(Latencia::ESPERA_DECOLAGEM, agora_ms - estado.pedido_ms);
+        agendar(agora_ms + static_cast<int64_t>(QUADROS_DECOLAGEM) * ATRASO_MOVIMENTO_MS,
+                aviao, TipoEvento::FIM_DECOLAGEM);
+        return;
+    }
+    registro_metricas.registrar(Latencia::ESPERA_PISTA, agora_ms - estado.pedido_ms);
+
+    agendar(agora_ms + config.tempo_pouso_ms, aviao, TipoEvento::FIM_POUSO);
+}
+
+void SimulacaoHeadless::atribuirVia(int aviao, int via) {
+    EstadoAviao& estado = avioes[aviao];
+    estado.via = via;
+    registro_metricas.registrar(Latencia::ESPERA_TAXI, agora_ms - estado.pedido_ms);
+    agendar(agora_ms + config.tempo_taxi_ms, aviao, TipoEvento::FIM_TAXI);
+}
+
+void SimulacaoHeadless::atribuirPortao(int aviao, int portao) {
+    EstadoAviao& estado = avioes[aviao];
+    estado.portao = portao;
+    registro_metricas.registrar(Latencia::ESPERA_PORTAO, agora_ms - estado.pedido_ms);
+    agendar(agora_ms + estado.desembarque_ms, aviao, TipoEvento::FIM_DESEMBARQUE);
+}
+
+// Libera a pista; o alocador a entrega diretamente ao próximo avião da fila
+void SimulacaoHeadless::liberarPista(EstadoAviao& estado) {
+    int pista = estado.pista;
+    resultado.ocupacao_pistas_ms[pista] += agora_ms - inicio_ocupacao_ms[pista];
+    registro_metricas.registrar(Latencia::OCUPACAO_PISTA, agora_ms - estado.concessao_pista_ms);
+    estado.pista = -1;
+    alocador_pistas.liberar(pista, agora_ms);
+    registro_metricas.amostrarFila(agora_ms, alocador_pistas.emEspera());
+}
+
+// Avança o estado de um avião de acordo com o evento
+void SimulacaoHeadless::processar(const Evento& evento) {
+    if(evento.tipo == TipoEvento::CHEGADA) {
+        chegar();
+        return;
+    }
+    EstadoAviao& estado = avioes[evento.aviao];
+
+    switch(evento.tipo) {
+        case TipoEvento::CHEGADA:
+            break;
+        case TipoEvento::INICIO_VOO:
+            iniciarVoo(evento.aviao);
+            break;
+        case TipoEvento::SOLICITA_POUSO:
+            pedirPista(evento.aviao);
+            break;
+        case TipoEvento::FIM_POUSO:
+            if(config.num_portoes == 0) {
+                agendar(agora_ms + estado.desembarque_ms, evento.aviao, TipoEvento::FIM_DESEMBARQUE);
+                break;
+            }
+            // A pista fica livre durante o táxi e o desembarque
+            liberarPista(estado);
+            pedirVia(evento.aviao);
+            break;
+        case TipoEvento::FIM_TAXI:
+            if(estado.via != -1) {
+                int via = estado.via;
+                estado.via = -1;
+                alocador_vias.liberar(via, agora_ms);
+            }
+            if(estado.desembarcou) {
+                pedirPista(evento.aviao);
+            } else {
+                pedirPortao(evento.aviao);
+            }
+            break;
+        case TipoEvento::FIM_DESEMBARQUE: {
+            if(config.num_portoes == 0) {
+                agendar(agora_ms + static_cast<int64_t>(QUADROS_DECOLAGEM) * ATRASO_MOVIMENTO_MS,
+                        evento.aviao, TipoEvento::FIM_DECOLAGEM);
+                break;
+            }
+            int portao = estado.portao;
+            estado.portao = -1;
+            estado.desembarcou = true;
+            alocador_portoes.liberar(portao, agora_ms);
+            pedirVia(evento.aviao);
+            break;
+        }
+        case TipoEvento::FIM_DECOLAGEM: {
+            if(estado.escalas_restantes > 0) {
+                // Segue para outro aeroporto da rede, que decide o destino e a chegada
+                AviaoEmTransito partida;
+                partida.partida_ms = agora_ms;
+                partida.chegada_ms = agora_ms;
+                partida.id = estado.id;
+                partida.gerador = estado.gerador;
+                partida.escalas_restantes = estado.escalas_restantes - 1;
+                partida.origem = aeroporto;
+                partida.destino = aeroporto;
+                partidas_pendentes.push_back(partida);
+            } else {
+                resultado.avioes_concluidos++;
+            }
+            registro_metricas.registrar(Latencia::CICLO_TOTAL, agora_ms - estado.inicio_voo_ms);
+            liberarPista(estado);
+            // Nenhum evento aponta mais para o avião: a posição fica para o próximo
+            livres.push_back(evento.aviao);
+            break;
+        }
+    }
+}
+
+// Executa a simulação até esgotar os eventos
+ResultadoSimulacao SimulacaoHeadless::executar() {
+    auto inicio = std::chrono::steady_clock::now();
+    iniciar();
+    executarAte(SEM_EVENTOS_MS);
+    ResultadoSimulacao final = concluir();
+    final.tempo_parede_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return final;
+}
+
+void SimulacaoHeadless::iniciar() {
+    agendarChegada();
+}
+
+int64_t SimulacaoHeadless::executarAte(int64_t limite_ms) {
+    while(!eventos.empty() && eventos.top().tempo_ms < limite_ms) {
+        Evento evento = eventos.top();
+        eventos.pop();
+        agora_ms = evento.tempo_ms;
+        processar(evento);
+        resultado.eventos_processados++;
+    }
+    return proximoEvento();
+}
+
+ResultadoSimulacao SimulacaoHeadless::concluir() {
+    resultado.tempo_simulado_ms = agora_ms;
+    resultado.politica = alocador_pistas.nomePolitica();
+    resultado.espera = alocador_pistas.estatisticas();
+    resultado.espera_taxi = alocador_vias.estatisticas();
+    resultado.espera_portoes = alocador_portoes.estatisticas();
+    resultado.fila_maxima_pistas = alocador_pistas.filaMaxima();
+    resultado.fila_maxima_taxi = alocador_vias.filaMaxima();
+    resultado.fila_maxima_portoes = alocador_portoes.filaMaxima();
+    registro_metricas.definirUsoPistas(alocador_pistas.usoAcumulado(), agora_ms);
+    registro_metricas.registrarContencao("alocador_pistas", &alocador_pistas.contencao());
+    if(config.num_portoes > 0) {
+        registro_metricas.registrarContencao("alocador_portoes", &alocador_portoes.contencao());
+        if(config.num_vias_taxi > 0) {
+            registro_metricas.registrarContencao("alocador_vias", &alocador_vias.contencao());
+        }
+    }
+    return resultado;
+}
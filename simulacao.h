@@ -0,0 +1,168 @@
+#ifndef SIMULACAO_H
+#define SIMULACAO_H
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <vector>
+#include "aleatorio.h"
+#include "configuracao.h"
+#include "alocador.h"
+#include "chegadas.h"
+#include "metricas.h"
+
+// Tipos de evento da simulação headless (mesmo ciclo de vida de aviao())
+enum class TipoEvento {
+    CHEGADA,            // Próxima chegada da fonte: o avião é criado e entra no céu
+    INICIO_VOO,         // Avião vindo de outro aeroporto entra no céu
+    SOLICITA_POUSO,     // Fim do tempo de voo: avião pede uma pista
+    FIM_POUSO,          // Fim do tempo de pouso
+    FIM_TAXI,           // Com portões: fim de um trecho de táxi (até o portão ou de volta à pista)
+    FIM_DESEMBARQUE,    // Fim do desembarque: começa a decolagem (com portões, libera o portão)
+    FIM_DECOLAGEM       // Fim da decolagem: pista liberada
+};
+
+// Evento agendado no relógio virtual (tempo em milissegundos)
+struct Evento {
+    int64_t tempo_ms;
+    uint64_t sequencia;     // Desempate estável para eventos no mesmo instante (chegadas primeiro)
+    int aviao;
+    TipoEvento tipo;
+
+    bool operator>(const Evento& outro) const {
+        if(tempo_ms != outro.tempo_ms) return tempo_ms > outro.tempo_ms;
+        return sequencia > outro.sequencia;
+    }
+};
+
+// Resultado agregado de uma execução headless
+struct ResultadoSimulacao {
+    int avioes_concluidos = 0;
+    uint64_t eventos_processados = 0;
+    int64_t tempo_simulado_ms = 0;
+    std::string politica;           // Política de escalonamento das pistas
+    EstatisticasEspera espera;      // Esperas por pista (média e percentis; com portões, pousos e decolagens)
+    EstatisticasEspera espera_taxi;     // Esperas por via de táxi (com portões e vias limitadas)
+    EstatisticasEspera espera_portoes;  // Esperas por portão
+    size_t fila_maxima_pistas = 0;      // Maior fila de cada estágio
+    size_t fila_maxima_taxi = 0;
+    size_t fila_maxima_portoes = 0;
+    std::vector<int64_t> ocupacao_pistas_ms; // Tempo ocupado de cada pista
+    double tempo_parede_s = 0.0;
+};
+
+// Avião que decolou de um aeroporto da rede com escalas restantes (ver rede.h)
+struct AviaoEmTransito {
+    int64_t partida_ms;         // Fim da decolagem na origem
+    int64_t chegada_ms;         // Entrada no céu do destino (definida pela rede)
+    uint64_t id;                // ID global, o mesmo em todos os aeroportos
+    GeradorAviao gerador;       // Segue a sequência de sorteios do avião
+    int escalas_restantes;      // Decolagens que ainda seguem para outro aeroporto
+    int origem;
+    int destino;
+};
+
+constexpr int64_t SEM_EVENTOS_MS = std::numeric_limits<int64_t>::max();
+
+// Sequência dos eventos que não são chegadas da fonte: as chegadas usam o
+// próprio número e, empatadas com outro evento, são processadas antes dele
+constexpr uint64_t SEQUENCIA_EVENTOS = 1ULL << 62;
+
+// Simulação por eventos discretos com relógio virtual, sem SDL e sem threads.
+// Executa o mesmo ciclo de vida de aviao() (voo, pedido de pista, pouso,
+// desembarque, decolagem e liberação) tão rápido quanto a CPU permitir.
+// Com portões o ciclo passa pelos mesmos estágios da versão gráfica: pista,
+// táxi, portão, táxi e pista de novo, cada um com seu alocador.
+//
+// Os aviões são criados só quando chegam: a fonte de chegadas (chegadas.h)
+// mantém um único evento CHEGADA na fila, e processá-lo cria o avião e agenda
+// a chegada seguinte. A memória no início não depende do número de voos, e
+// a posição de cada avião que decola é reaproveitada pelo próximo que chega,
+// então ela acompanha o pico de aviões simultâneos e não o total da execução;
+// dos que já saíram ficam só os contadores e histogramas do resultado.
+//
+// Na rede de aeroportos cada instância é um aeroporto: os aviões criados nele
+// têm IDs a partir de aeroporto * num_avioes + 1, os que decolam com escalas
+// restantes saem em partidas() em vez de concluir, e os que chegam de outro
+// aeroporto entram por receber(). A rede avança a simulação por janelas com
+// executarAte().
+class SimulacaoHeadless {
+public:
+    explicit SimulacaoHeadless(const Configuracao& config, int aeroporto = 0, int escalas = 0);
+
+    // Executa até não restarem eventos e devolve o resultado
+    ResultadoSimulacao executar();
+
+    // Partes de executar(): agenda a primeira chegada, processa os eventos
+    // anteriores a limite_ms (devolve o instante do próximo) e fecha o resultado
+    void iniciar();
+    int64_t executarAte(int64_t limite_ms);
+    ResultadoSimulacao concluir();
+
+    // Instante do próximo evento (SEM_EVENTOS_MS se não há)
+    int64_t proximoEvento() const { return eventos.empty() ? SEM_EVENTOS_MS : eventos.top().tempo_ms; }
+
+    // Decolagens para outros aeroportos desde a última vez que a rede as retirou
+    std::vector<AviaoEmTransito>& partidas() { return partidas_pendentes; }
+
+    // Avião vindo de outro aeroporto: entra no céu em chegada_ms
+    void receber(const AviaoEmTransito& aviao);
+
+    // Histogramas, fila, ocupação e contenção da execução, prontos após executar()
+    const RegistroMetricas& metricas() const { return registro_metricas; }
+
+private:
+    struct EstadoAviao {
+        int indice = 0;             // Posição em avioes (o alocador devolve o ponteiro)
+        uint64_t id = 0;
+        GeradorAviao gerador;
+        int escalas_restantes = 0;
+        int64_t desembarque_ms = 0;
+        bool emergencia = false;
+        int pista = -1;
+        int via = -1;               // Via de táxi em uso (-1: nenhuma ou vias sem limite)
+        int portao = -1;
+        bool desembarcou = false;   // Com portões: o próximo táxi e a próxima pista são da partida
+        int64_t inicio_voo_ms = 0;
+        int64_t pedido_ms = 0;      // Último pedido a um alocador
+        int64_t concessao_pista_ms = 0;
+    };
+
+    int adicionarAviao(uint64_t id, GeradorAviao gerador, int escalas);
+    void agendar(int64_t tempo_ms, int aviao, TipoEvento tipo);
+    void agendarChegada();
+    void chegar();
+    void iniciarVoo(int aviao);
+    void processar(const Evento& evento);
+    void pedirPista(int aviao);
+    void pedirVia(int aviao);
+    void pedirPortao(int aviao);
+    void atribuirPista(int aviao, int pista);
+    void atribuirVia(int aviao, int via);
+    void atribuirPortao(int aviao, int portao);
+    void liberarPista(EstadoAviao& estado);
+
+    Configuracao config;
+    int aeroporto;
+    int escalas;
+    int64_t agora_ms;
+    uint64_t proxima_sequencia;
+    std::unique_ptr<FonteChegadas> fonte_chegadas;
+    uint64_t chegadas_agendadas;        // Também a sequência da próxima chegada
+    uint64_t primeiro_id;               // ID do primeiro avião criado neste aeroporto
+    std::priority_queue<Evento, std::vector<Evento>, std::greater<Evento>> eventos;
+    std::deque<EstadoAviao> avioes;     // deque: chegadas não movem os aviões na fila do alocador
+    std::vector<int> livres;            // Posições de avioes liberadas na decolagem
+    std::vector<AviaoEmTransito> partidas_pendentes;
+    AlocadorRecursos alocador_pistas;   // Mesmo alocador com entrega direta da versão gráfica
+    AlocadorRecursos alocador_vias;     // Sem recursos quando as vias não têm limite
+    AlocadorRecursos alocador_portoes;  // Sem recursos sem portões
+    std::vector<int64_t> inicio_ocupacao_ms;
+    ResultadoSimulacao resultado;
+    RegistroMetricas registro_metricas;
+};
+
+#endif
@@ -1,29 +1,147 @@
 #include "utils.h"
 #include <iostream>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+// Cache de texturas de texto. Só a thread principal renderiza, então não há lock.
+namespace {
+
+struct ChaveTexto {
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    Uint32 cor;
+    std::string texto;
+
+    bool operator==(const ChaveTexto& outra) const {
+        return renderer == outra.renderer && font == outra.font && cor == outra.cor && texto == outra.texto;
+    }
+};
+
+struct HashChaveTexto {
+    size_t operator()(const ChaveTexto& chave) const {
+        size_t h = std::hash<std::string>()(chave.texto);
+        h ^= std::hash<const void*>()(chave.font) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= std::hash<Uint32>()(chave.cor) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+struct EntradaTexto {
+    SDL_Texture* textura;
+    int largura;
+    int altura;
+    uint64_t ultimo_uso;
+};
+
+// Limite de texturas em cache; rótulos que mudam (ex: valores da configuração) não crescem sem limite
+constexpr size_t CAPACIDADE_CACHE_TEXTO = 256;
+
+std::unordered_map<ChaveTexto, EntradaTexto, HashChaveTexto> cache_texto;
+uint64_t contador_uso_texto = 0;
+
+// Remove a entrada usada há mais tempo
+void descartarTextoMaisAntigo() {
+    auto mais_antigo = cache_texto.begin();
+    for(auto it = cache_texto.begin(); it != cache_texto.end(); ++it) {
+        if(it->second.ultimo_uso < mais_antigo->second.ultimo_uso) {
+            mais_antigo = it;
+        }
+    }
+    SDL_DestroyTexture(mais_antigo->second.textura);
+    cache_texto.erase(mais_antigo);
+}
+
+// Devolve a textura do texto, rasterizando-a apenas na primeira vez
+const EntradaTexto* obterTexto(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, SDL_Color cor) {
+    ChaveTexto chave{renderer, font,
+                     static_cast<Uint32>(cor.r) << 24 | static_cast<Uint32>(cor.g) << 16 |
+                     static_cast<Uint32>(cor.b) << 8 | cor.a,
+                     texto};
+    auto encontrado = cache_texto.find(chave);
+    if(encontrado != cache_texto.end()) {
+        encontrado->second.ultimo_uso = ++contador_uso_texto;
+        return &encontrado->second;
+    }
 
-// Função para renderizar texto usando SDL_ttf
-void renderizarTexto(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, int x, int y, SDL_Color cor) {
     // Renderiza texto para uma superfície
     SDL_Surface* superficie = TTF_RenderUTF8_Solid(font, texto.c_str(), cor);
     if (!superficie) {
         std::cerr << "Erro ao criar a superfície de texto: " << TTF_GetError() << std::endl;
-        return;
+        return nullptr;
     }
     // Cria textura a partir da superfície
     SDL_Texture* textura = SDL_CreateTextureFromSurface(renderer, superficie);
     if (!textura) {
         std::cerr << "Erro ao criar a textura de texto: " << SDL_GetError() << std::endl;
         SDL_FreeSurface(superficie);
+        return nullptr;
+    }
+    EntradaTexto entrada{textura, superficie->w, superficie->h, ++contador_uso_texto};
+    SDL_FreeSurface(superficie);
+
+    if(cache_texto.size() >= CAPACIDADE_CACHE_TEXTO) {
+        descartarTextoMaisAntigo();
+    }
+    return &cache_texto.emplace(std::move(chave), entrada).first->second;
+}
+
+} // namespace
+
+// Função para renderizar texto usando SDL_ttf; texto já visto custa um SDL_RenderCopy
+void renderizarTexto(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, int x, int y, SDL_Color cor) {
+    const EntradaTexto* entrada = obterTexto(renderer, font, texto, cor);
+    if(!entrada) {
         return;
     }
     // Define o retângulo de destino
-    SDL_Rect retanguloDestino = { x, y, superficie->w, superficie->h };
+    SDL_Rect retanguloDestino = { x, y, entrada->largura, entrada->altura };
     // Copia a textura para o renderer
-    SDL_RenderCopy(renderer, textura, NULL, &retanguloDestino);
-    // Limpeza
-    SDL_FreeSurface(superficie);
-    SDL_DestroyTexture(textura);
+    SDL_RenderCopy(renderer, entrada->textura, NULL, &retanguloDestino);
+}
+
+// Desenha os trechos lado a lado: os sem dígitos são os prefixos fixos do texto
+// e os dígitos são só dez texturas, sempre as mesmas
+void renderizarTextoVariavel(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, int x, int y, SDL_Color cor) {
+    std::string trecho;
+    size_t i = 0;
+    while(i < texto.size()) {
+        size_t fim = i + 1;
+        bool digito = texto[i] >= '0' && texto[i] <= '9';
+        while(!digito && fim < texto.size() && !(texto[fim] >= '0' && texto[fim] <= '9')) {
+            fim++;
+        }
+        trecho.assign(texto, i, fim - i);
+        i = fim;
+
+        const EntradaTexto* entrada = obterTexto(renderer, font, trecho, cor);
+        if(!entrada) {
+            return;
+        }
+        SDL_Rect retanguloDestino = { x, y, entrada->largura, entrada->altura };
+        SDL_RenderCopy(renderer, entrada->textura, NULL, &retanguloDestino);
+        x += entrada->largura;
+    }
+}
+
+// Função para obter o tamanho do texto sem rasterizá-lo a cada quadro
+bool tamanhoTexto(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, SDL_Color cor, int& largura, int& altura) {
+    const EntradaTexto* entrada = obterTexto(renderer, font, texto, cor);
+    if(!entrada) {
+        return false;
+    }
+    largura = entrada->largura;
+    altura = entrada->altura;
+    return true;
+}
+
+// Função para destruir as texturas em cache
+void liberarCacheTexto() {
+    for(auto& item : cache_texto) {
+        SDL_DestroyTexture(item.second.textura);
+    }
+    cache_texto.clear();
 }
 
 // Função para verificar se o mouse está dentro de um retângulo
@@ -32,10 +150,9 @@ bool mouse_noRetangulo(int mouseX, int mouseY, const SDL_Rect& retangulo) {
            mouseY >= retangulo.y && mouseY <= (retangulo.y + retangulo.h);
 }
 
-// Função para preencher triângulos manualmente com orientação
-void preencherTriangulo(SDL_Renderer* renderer, Sint16 x, Sint16 y, float tamanho, OrientacaoTriangulo orientacao, SDL_Color cor) {
-    Sint16 x1, y1, x2, y2, x3, y3;
-
+// Calcula os três vértices do triângulo com a orientação pedida
+static void verticesTriangulo(Sint16 x, Sint16 y, float tamanho, OrientacaoTriangulo orientacao,
+                              Sint16& x1, Sint16& y1, Sint16& x2, Sint16& y2, Sint16& x3, Sint16& y3) {
     switch(orientacao) {
         case OrientacaoTriangulo::DIREITA:
             x1 = x;
@@ -79,7 +196,11 @@ void preencherTriangulo(SDL_Renderer* renderer, Sint16 x, Sint16 y, float tamanh
             y3 = y + tamanho / 2;
             break;
     }
+}
 
+// Preenche um triângulo linha a linha (um SDL_RenderDrawLine por linha)
+static void preencherVertices(SDL_Renderer* renderer, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2,
+                              Sint16 x3, Sint16 y3, SDL_Color cor) {
     // Ordena os vértices por coordenada y crescente (y1 <= y2 <= y3)
     if (y2 < y1) { std::swap(x1, x2); std::swap(y1, y2); }
     if (y3 < y1) { std::swap(x1, x3); std::swap(y1, y3); }
@@ -112,3 +233,52 @@ void preencherTriangulo(SDL_Renderer* renderer, Sint16 x, Sint16 y, float tamanh
         atualX2 += dx1;
     }
 }
+
+// Função para preencher triângulos manualmente com orientação
+void preencherTriangulo(SDL_Renderer* renderer, Sint16 x, Sint16 y, float tamanho, OrientacaoTriangulo orientacao, SDL_Color cor) {
+    Sint16 x1, y1, x2, y2, x3, y3;
+    verticesTriangulo(x, y, tamanho, orientacao, x1, y1, x2, y2, x3, y3);
+    preencherVertices(renderer, x1, y1, x2, y2, x3, y3, cor);
+}
+
+LoteTriangulos::LoteTriangulos(size_t capacidade_triangulos) {
+    vertices.reserve(capacidade_triangulos * 3);
+}
+
+// Esvazia o lote mantendo a memória já alocada
+void LoteTriangulos::limpar() {
+    vertices.clear();
+}
+
+// Acrescenta um triângulo ao lote; nada é desenhado ainda
+void LoteTriangulos::adicionar(Sint16 x, Sint16 y, float tamanho, OrientacaoTriangulo orientacao, SDL_Color cor) {
+    Sint16 xs[3], ys[3];
+    verticesTriangulo(x, y, tamanho, orientacao, xs[0], ys[0], xs[1], ys[1], xs[2], ys[2]);
+    for(int i = 0; i < 3; ++i) {
+        SDL_Vertex vertice;
+        vertice.position = {static_cast<float>(xs[i]), static_cast<float>(ys[i])};
+        vertice.color = cor;
+        vertice.tex_coord = {0.0f, 0.0f};
+        vertices.push_back(vertice);
+    }
+}
+
+// Desenha todos os triângulos do lote com uma única chamada ao renderer
+void LoteTriangulos::desenhar(SDL_Renderer* renderer) {
+    if(vertices.empty()) {
+        return;
+    }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(SDL_RenderGeometry(renderer, NULL, vertices.data(), static_cast<int>(vertices.size()), NULL, 0) == 0) {
+        return;
+    }
+#endif
+    // Sem SDL_RenderGeometry (SDL < 2.0.18 ou falha do backend): preenchimento por linhas
+    for(size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        preencherVertices(renderer,
+                          static_cast<Sint16>(vertices[i].position.x), static_cast<Sint16>(vertices[i].position.y),
+                          static_cast<Sint16>(vertices[i + 1].position.x), static_cast<Sint16>(vertices[i + 1].position.y),
+                          static_cast<Sint16>(vertices[i + 2].position.x), static_cast<Sint16>(vertices[i + 2].position.y),
+                          vertices[i].color);
+    }
+}
@@ -4,10 +4,22 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 #include <string>
+#include <vector>
 
-// Função para renderizar texto
+// Função para renderizar texto (texturas ficam em cache por texto, fonte e cor)
 void renderizarTexto(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, int x, int y, SDL_Color cor);
 
+// Texto que muda a cada quadro só nos números (relógio, contadores): os trechos
+// sem dígitos e cada dígito vêm do cache separadamente, então um valor novo não
+// rasteriza nada nem ocupa entradas novas do cache
+void renderizarTextoVariavel(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, int x, int y, SDL_Color cor);
+
+// Função para obter o tamanho do texto renderizado, usando o mesmo cache
+bool tamanhoTexto(SDL_Renderer* renderer, TTF_Font* font, const std::string& texto, SDL_Color cor, int& largura, int& altura);
+
+// Função para destruir as texturas em cache (chamar antes de destruir o renderer ou a fonte)
+void liberarCacheTexto();
+
 // Função para verificar se o mouse está dentro de um retângulo
 bool mouse_noRetangulo(int mouseX, int mouseY, const SDL_Rect& retangulo);
 
@@ -19,7 +31,23 @@ enum class OrientacaoTriangulo {
     CIMA   // Para aviões decolando
 };
 
-// Função para preencher triângulos manualmente com orientação
+// Função para preencher triângulos manualmente com orientação (uma chamada por linha; usada como fallback)
 void preencherTriangulo(SDL_Renderer* renderer, Sint16 x, Sint16 y, float tamanho, OrientacaoTriangulo orientacao, SDL_Color cor);
 
+// Lote de triângulos enviado ao renderer com uma única chamada a SDL_RenderGeometry.
+// O buffer de vértices é reaproveitado entre quadros.
+class LoteTriangulos {
+public:
+    explicit LoteTriangulos(size_t capacidade_triangulos = 1024);
+
+    void limpar();
+    void adicionar(Sint16 x, Sint16 y, float tamanho, OrientacaoTriangulo orientacao, SDL_Color cor);
+    void desenhar(SDL_Renderer* renderer);
+
+    size_t numTriangulos() const { return vertices.size() / 3; }
+
+private:
+    std::vector<SDL_Vertex> vertices;
+};
+
 #endif 
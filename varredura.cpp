@@ -0,0 +1,378 @@
+#include "varredura.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// Lê um número inteiro não negativo do texto, sem sobras
+template <class T>
+bool lerNumero(const std::string& texto, T& valor) {
+    if(texto.empty() || texto[0] == '-') {
+        return false;
+    }
+    errno = 0;
+    char* fim = nullptr;
+    unsigned long long lido = std::strtoull(texto.c_str(), &fim, 10);
+    if(errno != 0 || *fim != '\0' || lido > static_cast<unsigned long long>(std::numeric_limits<T>::max())) {
+        return false;
+    }
+    valor = static_cast<T>(lido);
+    return true;
+}
+
+// Lê segundos não negativos com até três casas decimais ("5", "0.25") em
+// milissegundos exatos, para intervalos como "0.5..2:0.25" não acumularem arredondamento
+bool lerSegundos(const std::string& texto, int64_t& ms) {
+    size_t ponto = texto.find('.');
+    std::string inteiro = texto.substr(0, ponto);
+    std::string fracao = ponto == std::string::npos ? "" : texto.substr(ponto + 1);
+    int64_t segundos = 0, milesimos = 0;
+    if(!lerNumero(inteiro, segundos) || fracao.size() > 3 ||
+       (ponto != std::string::npos && !lerNumero(fracao, milesimos)) ||
+       segundos > std::numeric_limits<int64_t>::max() / 1000 - 1) {
+        return false;
+    }
+    fracao.resize(3, '0');
+    lerNumero(fracao, milesimos);
+    ms = segundos * 1000 + milesimos;
+    return true;
+}
+
+// Um valor ("7"), um intervalo ("1..5") ou um intervalo com passo ("0..100:25"),
+// cada número lido por `ler`
+template <class T, class Leitor>
+bool lerValores(const std::string& token, std::vector<T>& valores, Leitor ler) {
+    size_t pontos = token.find("..");
+    if(pontos == std::string::npos) {
+        T valor;
+        if(!ler(token, valor)) {
+            return false;
+        }
+        valores.push_back(valor);
+        return true;
+    }
+
+    std::string resto = token.substr(pontos + 2);
+    size_t dois_pontos = resto.find(':');
+    T inicio, fim, passo = 1;
+    if(!ler(token.substr(0, pontos), inicio) || !ler(resto.substr(0, dois_pontos), fim) ||
+       (dois_pontos != std::string::npos && !ler(resto.substr(dois_pontos + 1), passo)) ||
+       passo == 0 || fim < inicio) {
+        return false;
+    }
+    for(T valor = inicio; ; valor += passo) {
+        valores.push_back(valor);
+        if(fim - valor < passo) {
+            break;
+        }
+    }
+    return true;
+}
+
+template <class T>
+bool lerValores(const std::string& token, std::vector<T>& valores) {
+    return lerValores(token, valores, [](const std::string& texto, T& valor) { return lerNumero(texto, valor); });
+}
+
+// Separa os valores de uma linha por vírgulas e espaços
+std::vector<std::string> separarValores(const std::string& texto) {
+    std::string limpo = texto;
+    std::replace(limpo.begin(), limpo.end(), ',', ' ');
+    std::istringstream entrada(limpo);
+    std::vector<std::string> tokens;
+    std::string token;
+    while(entrada >> token) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+std::string aparar(const std::string& texto) {
+    size_t inicio = texto.find_first_not_of(" \t\r");
+    if(inicio == std::string::npos) {
+        return "";
+    }
+    size_t fim = texto.find_last_not_of(" \t\r");
+    return texto.substr(inicio, fim - inicio + 1);
+}
+
+// Fração média do tempo simulado em que as pistas ficaram ocupadas, em %
+double ocupacaoMedia(const ResultadoSimulacao& resultado) {
+    if(resultado.tempo_simulado_ms <= 0 || resultado.ocupacao_pistas_ms.empty()) {
+        return 0.0;
+    }
+    long double soma = 0;
+    for(int64_t ocupacao : resultado.ocupacao_pistas_ms) {
+        soma += ocupacao;
+    }
+    return static_cast<double>(100.0L * soma / resultado.ocupacao_pistas_ms.size() / resultado.tempo_simulado_ms);
+}
+
+double avioesPorHora(const ResultadoSimulacao& resultado) {
+    return resultado.tempo_simulado_ms > 0 ? resultado.avioes_concluidos * 3600000.0 / resultado.tempo_simulado_ms : 0.0;
+}
+
+} // namespace
+
+bool lerVarredura(std::istream& entrada, const Configuracao& base, EspecificacaoVarredura& especificacao,
+                  std::string& erro) {
+    especificacao = EspecificacaoVarredura();
+    std::string linha;
+    int numero_linha = 0;
+    while(std::getline(entrada, linha)) {
+        ++numero_linha;
+        linha = aparar(linha.substr(0, linha.find('#')));
+        if(linha.empty()) {
+            continue;
+        }
+
+        size_t igual = linha.find('=');
+        std::string chave = aparar(linha.substr(0, igual));
+        std::vector<std::string> tokens = separarValores(igual == std::string::npos ? "" : linha.substr(igual + 1));
+        if(igual == std::string::npos || tokens.empty()) {
+            erro = "linha " + std::to_string(numero_linha) + ": esperado \"chave = valores\"";
+            return false;
+        }
+
+        bool valido = true;
+        if(chave == "politica") {
+            for(const std::string& token : tokens) {
+                TipoPolitica tipo = TipoPolitica::FIFO;
+                valido = valido && politicaPorNome(token, tipo);
+                especificacao.politicas.push_back(tipo);
+            }
+        } else if(chave == "chegadas") {
+            for(const std::string& token : tokens) {
+                TipoChegadas tipo = TipoChegadas::REGULAR;
+                valido = valido && chegadasPorNome(token, tipo);
+                especificacao.chegadas.push_back(tipo);
+            }
+        } else if(chave == "semente") {
+            for(const std::string& token : tokens) {
+                valido = valido && lerValores(token, especificacao.sementes);
+            }
+        } else if(chave == "pouso" || chave == "desembarque" || chave == "decolagem" || chave == "intervalo" ||
+                  chave == "taxi") {
+            // Tempos em segundos, guardados em milissegundos
+            std::vector<int64_t>* eixo = chave == "pouso"       ? &especificacao.pouso_ms
+                                       : chave == "desembarque" ? &especificacao.desembarque_ms
+                                       : chave == "decolagem"   ? &especificacao.decolagem_ms
+                                       : chave == "taxi"        ? &especificacao.taxi_ms
+                                                                : &especificacao.intervalo_ms;
+            for(const std::string& token : tokens) {
+                valido = valido && lerValores(token, *eixo, lerSegundos);
+            }
+        } else {
+            std::vector<int>* eixo = nullptr;
+            if(chave == "pistas") eixo = &especificacao.pistas;
+            else if(chave == "avioes") eixo = &especificacao.avioes;
+            else if(chave == "emergencias") eixo = &especificacao.emergencias;
+            else if(chave == "variacao-desembarque") eixo = &especificacao.variacao_desembarque;
+            else if(chave == "portoes") eixo = &especificacao.portoes;
+            else if(chave == "vias-taxi") eixo = &especificacao.vias_taxi;
+
+            if(!eixo) {
+                erro = "linha " + std::to_string(numero_linha) + ": chave desconhecida \"" + chave + "\"";
+                return false;
+            }
+            for(const std::string& token : tokens) {
+                valido = valido && lerValores(token, *eixo);
+            }
+        }
+        if(!valido) {
+            erro = "linha " + std::to_string(numero_linha) + ": valor inválido para \"" + chave + "\"";
+            return false;
+        }
+    }
+
+    // Eixos não informados ficam com o valor da configuração base
+    auto completar = [](auto& eixo, auto valor) {
+        if(eixo.empty()) eixo.push_back(valor);
+    };
+    completar(especificacao.pouso_ms, base.tempo_pouso_ms);
+    completar(especificacao.desembarque_ms, base.tempo_desembarque_ms);
+    completar(especificacao.decolagem_ms, base.tempo_decolagem_ms);
+    completar(especificacao.intervalo_ms, base.tempo_entre_avioes_ms);
+    completar(especificacao.pistas, base.num_pistas);
+    completar(especificacao.avioes, base.num_avioes);
+    completar(especificacao.emergencias, base.percentual_emergencias);
+    completar(especificacao.variacao_desembarque, base.variacao_desembarque);
+    completar(especificacao.portoes, base.num_portoes);
+    completar(especificacao.vias_taxi, base.num_vias_taxi);
+    completar(especificacao.taxi_ms, base.tempo_taxi_ms);
+    if(especificacao.politicas.empty()) especificacao.politicas.push_back(base.politica_pistas);
+    if(especificacao.chegadas.empty()) especificacao.chegadas.push_back(base.chegadas);
+    if(especificacao.sementes.empty()) especificacao.sementes.push_back(base.semente);
+
+    for(int pistas : especificacao.pistas) {
+        if(pistas < 1) {
+            erro = "é necessário ao menos uma pista";
+            return false;
+        }
+    }
+    for(int percentual : especificacao.emergencias) {
+        if(percentual > 100) {
+            erro = "emergencias deve estar entre 0 e 100";
+            return false;
+        }
+    }
+    for(int percentual : especificacao.variacao_desembarque) {
+        if(percentual > 100) {
+            erro = "variacao-desembarque deve estar entre 0 e 100";
+            return false;
+        }
+    }
+    return true;
+}
+
+// A semente varia mais rápido, para as repetições de uma mesma configuração ficarem em linhas seguidas
+std::vector<Configuracao> expandirVarredura(const EspecificacaoVarredura& e) {
+    std::vector<Configuracao> configuracoes;
+    Configuracao config;
+    for(int pistas : e.pistas)
+    for(int avioes : e.avioes)
+    for(int64_t intervalo : e.intervalo_ms)
+    for(int64_t pouso : e.pouso_ms)
+    for(int64_t desembarque : e.desembarque_ms)
+    for(int64_t decolagem : e.decolagem_ms)
+    for(int emergencias : e.emergencias)
+    for(int variacao : e.variacao_desembarque)
+    for(int portoes : e.portoes)
+    for(int vias : e.vias_taxi)
+    for(int64_t taxi : e.taxi_ms)
+    for(TipoPolitica politica : e.politicas)
+    for(TipoChegadas chegadas : e.chegadas)
+    for(uint64_t semente : e.sementes) {
+        config.num_pistas = pistas;
+        config.num_avioes = avioes;
+        config.tempo_entre_avioes_ms = intervalo;
+        config.tempo_pouso_ms = pouso;
+        config.tempo_desembarque_ms = desembarque;
+        config.tempo_decolagem_ms = decolagem;
+        config.percentual_emergencias = emergencias;
+        config.variacao_desembarque = variacao;
+        config.num_portoes = portoes;
+        config.num_vias_taxi = vias;
+        config.tempo_taxi_ms = taxi;
+        config.politica_pistas = politica;
+        config.chegadas = chegadas;
+        config.semente = semente;
+        configuracoes.push_back(config);
+    }
+    return configuracoes;
+}
+
+// Cada thread pega a próxima execução de um índice compartilhado; as simulações
+// não compartilham estado, então não há outra sincronização além do progresso
+std::vector<ResultadoSimulacao> executarVarredura(const std::vector<Configuracao>& configuracoes, unsigned threads) {
+    std::vector<ResultadoSimulacao> resultados(configuracoes.size());
+    if(threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, configuracoes.size())));
+
+    std::atomic<size_t> proxima(0);
+    std::mutex mutex_progresso;
+    size_t concluidas = 0;
+    size_t proximo_aviso = 1;
+    auto trabalhar = [&] {
+        for(size_t i = proxima.fetch_add(1); i < configuracoes.size(); i = proxima.fetch_add(1)) {
+            SimulacaoHeadless simulacao(configuracoes[i]);
+            resultados[i] = simulacao.executar();
+
+            // Progresso a cada 10% concluído
+            std::lock_guard<std::mutex> lock(mutex_progresso);
+            ++concluidas;
+            if(concluidas * 10 >= proximo_aviso * configuracoes.size()) {
+                std::cerr << "[" << concluidas << "/" << configuracoes.size() << "] execuções concluídas\n";
+                while(concluidas * 10 >= proximo_aviso * configuracoes.size()) {
+                    ++proximo_aviso;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> grupo;
+    for(unsigned t = 1; t < threads; ++t) {
+        grupo.emplace_back(trabalhar);
+    }
+    trabalhar();
+    for(std::thread& t : grupo) {
+        t.join();
+    }
+    return resultados;
+}
+
+bool salvarVarredura(const std::string& caminho, const std::vector<Configuracao>& configuracoes,
+                     const std::vector<ResultadoSimulacao>& resultados) {
+    std::ofstream arquivo(caminho);
+    if(!arquivo) {
+        return false;
+    }
+    bool csv = caminho.size() >= 4 && caminho.compare(caminho.size() - 4, 4, ".csv") == 0;
+    if(csv) {
+        exportarVarreduraCsv(arquivo, configuracoes, resultados);
+    } else {
+        exportarVarreduraJson(arquivo, configuracoes, resultados);
+    }
+    return static_cast<bool>(arquivo);
+}
+
+void exportarVarreduraCsv(std::ostream& saida, const std::vector<Configuracao>& configuracoes,
+                          const std::vector<ResultadoSimulacao>& resultados) {
+    saida << "pistas,avioes,intervalo_s,pouso_s,desembarque_s,decolagem_s,emergencias_pct,variacao_desembarque_pct,"
+             "portoes,vias_taxi,taxi_s,politica,chegadas,semente,avioes_concluidos,eventos,tempo_simulado_s,avioes_por_hora,"
+             "espera_media_s,espera_p50_s,espera_p95_s,espera_p99_s,espera_maxima_s,espera_portao_media_s,"
+             "fila_maxima_pistas,fila_maxima_portoes,ocupacao_media_pct,tempo_parede_s\n";
+    for(size_t i = 0; i < configuracoes.size(); ++i) {
+        const Configuracao& c = configuracoes[i];
+        const ResultadoSimulacao& r = resultados[i];
+        saida << c.num_pistas << "," << c.num_avioes << "," << c.tempo_entre_avioes_ms / 1000.0 << ","
+              << c.tempo_pouso_ms / 1000.0 << "," << c.tempo_desembarque_ms / 1000.0 << ","
+              << c.tempo_decolagem_ms / 1000.0 << "," << c.percentual_emergencias << ","
+              << c.variacao_desembarque << "," << c.num_portoes << "," << c.num_vias_taxi << ","
+              << c.tempo_taxi_ms / 1000.0 << "," << nomePolitica(c.politica_pistas) << "," << nomeChegadas(c.chegadas) << ","
+              << c.semente << ","
+              << r.avioes_concluidos << "," << r.eventos_processados << "," << r.tempo_simulado_ms / 1000.0 << ","
+              << avioesPorHora(r) << "," << r.espera.media_ms / 1000.0 << "," << r.espera.p50_ms / 1000.0 << ","
+              << r.espera.p95_ms / 1000.0 << "," << r.espera.p99_ms / 1000.0 << "," << r.espera.maxima_ms / 1000.0 << ","
+              << r.espera_portoes.media_ms / 1000.0 << "," << r.fila_maxima_pistas << "," << r.fila_maxima_portoes << ","
+              << ocupacaoMedia(r) << "," << r.tempo_parede_s << "\n";
+    }
+}
+
+void exportarVarreduraJson(std::ostream& saida, const std::vector<Configuracao>& configuracoes,
+                           const std::vector<ResultadoSimulacao>& resultados) {
+    saida << "[";
+    for(size_t i = 0; i < configuracoes.size(); ++i) {
+        const Configuracao& c = configuracoes[i];
+        const ResultadoSimulacao& r = resultados[i];
+        saida << (i ? ",\n " : "\n ")
+              << "{\"pistas\": " << c.num_pistas << ", \"avioes\": " << c.num_avioes
+              << ", \"intervalo_s\": " << c.tempo_entre_avioes_ms / 1000.0 << ", \"pouso_s\": " << c.tempo_pouso_ms / 1000.0
+              << ", \"desembarque_s\": " << c.tempo_desembarque_ms / 1000.0 << ", \"decolagem_s\": " << c.tempo_decolagem_ms / 1000.0
+              << ", \"emergencias_pct\": " << c.percentual_emergencias
+              << ", \"variacao_desembarque_pct\": " << c.variacao_desembarque
+              << ", \"portoes\": " << c.num_portoes << ", \"vias_taxi\": " << c.num_vias_taxi
+              << ", \"taxi_s\": " << c.tempo_taxi_ms / 1000.0
+              << ", \"politica\": \"" << nomePolitica(c.politica_pistas) << "\", \"chegadas\": \""
+              << nomeChegadas(c.chegadas) << "\", \"semente\": " << c.semente
+              << ", \"avioes_concluidos\": " << r.avioes_concluidos << ", \"eventos\": " << r.eventos_processados
+              << ", \"tempo_simulado_s\": " << r.tempo_simulado_ms / 1000.0 << ", \"avioes_por_hora\": " << avioesPorHora(r)
+              << ", \"espera_media_s\": " << r.espera.media_ms / 1000.0 << ", \"espera_p50_s\": " << r.espera.p50_ms / 1000.0
+              << ", \"espera_p95_s\": " << r.espera.p95_ms / 1000.0 << ", \"espera_p99_s\": " << r.espera.p99_ms / 1000.0
+              << ", \"espera_maxima_s\": " << r.espera.maxima_ms / 1000.0
+              << ", \"espera_portao_media_s\": " << r.espera_portoes.media_ms / 1000.0
+              << ", \"fila_maxima_pistas\": " << r.fila_maxima_pistas << ", \"fila_maxima_portoes\": " << r.fila_maxima_portoes
+              << ", \"ocupacao_media_pct\": " << ocupacaoMedia(r) << ", \"tempo_parede_s\": " << r.tempo_parede_s << "}";
+    }
+    saida << "\n]\n";
+}
@@ -0,0 +1,54 @@
+#ifndef VARREDURA_H
+#define VARREDURA_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "configuracao.h"
+#include "simulacao.h"
+
+// Eixos de uma varredura de parâmetros: cada campo assume todos os valores da
+// sua lista e as execuções são o produto cartesiano dos eixos
+struct EspecificacaoVarredura {
+    std::vector<int64_t> pouso_ms;
+    std::vector<int64_t> desembarque_ms;
+    std::vector<int64_t> decolagem_ms;
+    std::vector<int64_t> intervalo_ms;
+    std::vector<int64_t> taxi_ms;
+    std::vector<int> pistas;
+    std::vector<int> avioes;
+    std::vector<int> emergencias;
+    std::vector<int> variacao_desembarque;
+    std::vector<int> portoes;
+    std::vector<int> vias_taxi;
+    std::vector<TipoPolitica> politicas;
+    std::vector<TipoChegadas> chegadas;     // Só as sorteadas (a programação em arquivo fica de fora)
+    std::vector<uint64_t> sementes;
+};
+
+// Lê a especificação: uma linha "chave = valores" por eixo, '#' inicia comentário.
+// Os valores são separados por vírgulas ou espaços e cada um é um número, um
+// intervalo "a..b" ou "a..b:passo" (ou um nome, em "politica" e "chegadas"). Os tempos são
+// em segundos com até três casas decimais ("0.5..2:0.25"). Eixos ausentes
+// ficam com o valor de `base`. Em caso de erro devolve false e descreve a linha em `erro`.
+bool lerVarredura(std::istream& entrada, const Configuracao& base, EspecificacaoVarredura& especificacao,
+                  std::string& erro);
+
+// Uma configuração por combinação, na ordem em que aparecem na tabela
+std::vector<Configuracao> expandirVarredura(const EspecificacaoVarredura& especificacao);
+
+// Executa as simulações headless em paralelo (threads = 0: uma por núcleo).
+// Os resultados saem na mesma ordem das configurações, qualquer que seja a ordem de término.
+std::vector<ResultadoSimulacao> executarVarredura(const std::vector<Configuracao>& configuracoes, unsigned threads);
+
+// Tabela agregada, uma linha por execução; o formato é escolhido pela extensão (.csv ou JSON)
+bool salvarVarredura(const std::string& caminho, const std::vector<Configuracao>& configuracoes,
+                     const std::vector<ResultadoSimulacao>& resultados);
+void exportarVarreduraCsv(std::ostream& saida, const std::vector<Configuracao>& configuracoes,
+                          const std::vector<ResultadoSimulacao>& resultados);
+void exportarVarreduraJson(std::ostream& saida, const std::vector<Configuracao>& configuracoes,
+                           const std::vector<ResultadoSimulacao>& resultados);
+
+#endif